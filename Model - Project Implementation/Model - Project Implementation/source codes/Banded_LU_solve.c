@@ -0,0 +1,442 @@
+/*
+Group 03
+
+Hani Abdallah - 21400302
+Houssam Eddine Jamil Nasser - 21400407
+Tan Viet Nguyen - 21400381
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// The banded solver is used while the stored band (2 * kl + ku + 1 columns) is at most this fraction of n
+#define BAND_DENSITY_LIMIT 0.25
+
+// Entry (i, j) of a band matrix, row i stores the columns i - kl .. i + ku + kl
+#define BAND(B, kl, i, j) ((B)[i][(j) - (i) + (kl)])
+
+enum ERROR_CODES
+{
+    OK,
+    INCORRECT_MATRIX,
+    CALCULATION_ERROR
+};
+
+enum SOLVER_KINDS
+{
+    THOMAS_SOLVER,
+    BANDED_SOLVER,
+    DENSE_SOLVER
+};
+
+// allocate memory for matrices
+double **allocateMatrix(int rows, int columns)
+{
+    double **matrix = (double **)malloc(rows * sizeof(double *));
+    for (int i = 0; i < rows; i++)
+    {
+        matrix[i] = (double *)malloc(columns * sizeof(double));
+    }
+    return matrix;
+}
+
+// free allocated memory of matrices
+void freeMatrix(double **matrix, int rows)
+{
+    for (int i = 0; i < rows; i++)
+    {
+        free(matrix[i]);
+    }
+    free(matrix);
+}
+
+// Lower (kl) and upper (ku) bandwidth: the farthest nonzero below and above the diagonal
+void detectBandwidth(double **A, int n, int *kl, int *ku)
+{
+    *kl = 0;
+    *ku = 0;
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            if (A[i][j] != 0.0)
+            {
+                if (i - j > *kl)
+                {
+                    *kl = i - j;
+                }
+                if (j - i > *ku)
+                {
+                    *ku = j - i;
+                }
+            }
+        }
+    }
+}
+
+// Thomas algorithm for a tridiagonal system in O(n), without pivoting
+// sub, diag and super are the three diagonals (sub[0] and super[n-1] are unused)
+int thomasSolve(double *sub, double *diag, double *super, double *b, double *x, int n)
+{
+    double *c = malloc(n * sizeof(double));
+    int status = OK;
+
+    double pivot = diag[0];
+    for (int i = 0; i < n; i++)
+    {
+        if (i > 0)
+        {
+            pivot = diag[i] - sub[i] * c[i - 1];
+        }
+        if (pivot == 0.0)
+        {
+            status = CALCULATION_ERROR;
+            break;
+        }
+        c[i] = (i < n - 1) ? super[i] / pivot : 0.0;
+        x[i] = (b[i] - ((i > 0) ? sub[i] * x[i - 1] : 0.0)) / pivot;
+    }
+
+    if (status == OK)
+    {
+        for (int i = n - 2; i >= 0; i--)
+        {
+            x[i] -= c[i] * x[i + 1];
+        }
+    }
+
+    free(c);
+    return status;
+}
+
+// Thomas is only stable without pivoting when the tridiagonal is diagonally dominant by rows or by columns
+// (the multipliers then stay bounded by 1), any other tridiagonal goes to the pivoted banded LU
+int isTridiagonalDominant(double *sub, double *diag, double *super, int n)
+{
+    int rows = 1;
+    int columns = 1;
+    for (int i = 0; i < n && (rows || columns); i++)
+    {
+        double row_sum = ((i > 0) ? fabs(sub[i]) : 0.0) + ((i < n - 1) ? fabs(super[i]) : 0.0);
+        double column_sum = ((i > 0) ? fabs(super[i - 1]) : 0.0) + ((i < n - 1) ? fabs(sub[i + 1]) : 0.0);
+        if (fabs(diag[i]) < row_sum)
+        {
+            rows = 0;
+        }
+        if (fabs(diag[i]) < column_sum)
+        {
+            columns = 0;
+        }
+    }
+    return rows || columns;
+}
+
+// Pack A into compact band storage: n rows of 2 * kl + ku + 1 entries
+// The kl extra entries on the right of every row hold the fill-in created by row interchanges
+double **toBandStorage(double **A, int n, int kl, int ku)
+{
+    int width = 2 * kl + ku + 1;
+    double **B = allocateMatrix(n, width);
+    for (int i = 0; i < n; i++)
+    {
+        memset(B[i], 0, width * sizeof(double));
+        int first = (i - kl > 0) ? i - kl : 0;
+        int last = (i + ku < n - 1) ? i + ku : n - 1;
+        for (int j = first; j <= last; j++)
+        {
+            BAND(B, kl, i, j) = A[i][j];
+        }
+    }
+    return B;
+}
+
+// Banded LU with partial pivoting in O(n * kl * (kl + ku)), B is overwritten by the factors
+// The pivot of column k is searched in rows k .. k + kl only, so U gets at most kl + ku superdiagonals
+int bandedFactorize(double **B, int n, int kl, int ku, int *ipiv)
+{
+    for (int k = 0; k < n; k++)
+    {
+        int last_row = (k + kl < n - 1) ? k + kl : n - 1;
+        int last_column = (k + kl + ku < n - 1) ? k + kl + ku : n - 1;
+
+        int pivot = k;
+        for (int i = k + 1; i <= last_row; i++)
+        {
+            if (fabs(BAND(B, kl, i, k)) > fabs(BAND(B, kl, pivot, k)))
+            {
+                pivot = i;
+            }
+        }
+        ipiv[k] = pivot;
+        if (BAND(B, kl, pivot, k) == 0.0)
+        {
+            return CALCULATION_ERROR;
+        }
+        if (pivot != k)
+        {
+            for (int j = k; j <= last_column; j++)
+            {
+                double temp = BAND(B, kl, k, j);
+                BAND(B, kl, k, j) = BAND(B, kl, pivot, j);
+                BAND(B, kl, pivot, j) = temp;
+            }
+        }
+
+        for (int i = k + 1; i <= last_row; i++)
+        {
+            double factor = BAND(B, kl, i, k) / BAND(B, kl, k, k);
+            BAND(B, kl, i, k) = factor;
+            for (int j = k + 1; j <= last_column; j++)
+            {
+                BAND(B, kl, i, j) -= factor * BAND(B, kl, k, j);
+            }
+        }
+    }
+    return OK;
+}
+
+// Solve with the banded factors, x holds b on entry and the solution on return
+void bandedSolve(double **B, int n, int kl, int ku, int *ipiv, double *x)
+{
+    // L y = P b, the interchanges are replayed in the order they were made
+    for (int k = 0; k < n; k++)
+    {
+        if (ipiv[k] != k)
+        {
+            double temp = x[k];
+            x[k] = x[ipiv[k]];
+            x[ipiv[k]] = temp;
+        }
+        int last_row = (k + kl < n - 1) ? k + kl : n - 1;
+        for (int i = k + 1; i <= last_row; i++)
+        {
+            x[i] -= BAND(B, kl, i, k) * x[k];
+        }
+    }
+
+    // U x = y
+    for (int i = n - 1; i >= 0; i--)
+    {
+        int last_column = (i + kl + ku < n - 1) ? i + kl + ku : n - 1;
+        for (int j = i + 1; j <= last_column; j++)
+        {
+            x[i] -= BAND(B, kl, i, j) * x[j];
+        }
+        x[i] /= BAND(B, kl, i, i);
+    }
+}
+
+// Dense LU solve with partial pivoting, used when the band is too wide to pay off
+int denseSolve(double **A, int n, double *b, double *x)
+{
+    double **LU = allocateMatrix(n, n);
+    for (int i = 0; i < n; i++)
+    {
+        memcpy(LU[i], A[i], n * sizeof(double));
+        x[i] = b[i];
+    }
+
+    int status = OK;
+    for (int k = 0; k < n && status == OK; k++)
+    {
+        int pivot = k;
+        for (int i = k + 1; i < n; i++)
+        {
+            if (fabs(LU[i][k]) > fabs(LU[pivot][k]))
+            {
+                pivot = i;
+            }
+        }
+        if (LU[pivot][k] == 0.0)
+        {
+            status = CALCULATION_ERROR;
+            break;
+        }
+        if (pivot != k)
+        {
+            double *row = LU[k];
+            LU[k] = LU[pivot];
+            LU[pivot] = row;
+            double temp = x[k];
+            x[k] = x[pivot];
+            x[pivot] = temp;
+        }
+        for (int i = k + 1; i < n; i++)
+        {
+            double factor = LU[i][k] / LU[k][k];
+            for (int j = k + 1; j < n; j++)
+            {
+                LU[i][j] -= factor * LU[k][j];
+            }
+            x[i] -= factor * x[k];
+        }
+    }
+
+    if (status == OK)
+    {
+        for (int i = n - 1; i >= 0; i--)
+        {
+            for (int j = i + 1; j < n; j++)
+            {
+                x[i] -= LU[i][j] * x[j];
+            }
+            x[i] /= LU[i][i];
+        }
+    }
+
+    freeMatrix(LU, n);
+    return status;
+}
+
+// Solver front end: scans A for its bandwidth and dispatches to the cheapest solver
+// diagonally dominant tridiagonal -> Thomas, other tridiagonal or narrow band -> banded LU, otherwise dense LU
+// The solver actually used is returned in solver (Thomas falls back to banded LU on a zero pivot)
+int solveSystem(double **A, int n, double *b, double *x, int *kl, int *ku, int *solver)
+{
+    if (A == NULL || b == NULL || x == NULL || n < 1)
+    {
+        return INCORRECT_MATRIX;
+    }
+
+    detectBandwidth(A, n, kl, ku);
+
+    if (*kl <= 1 && *ku <= 1)
+    {
+        double *sub = malloc(n * sizeof(double));
+        double *diag = malloc(n * sizeof(double));
+        double *super = malloc(n * sizeof(double));
+        for (int i = 0; i < n; i++)
+        {
+            sub[i] = (i > 0) ? A[i][i - 1] : 0.0;
+            diag[i] = A[i][i];
+            super[i] = (i < n - 1) ? A[i][i + 1] : 0.0;
+        }
+        int status = CALCULATION_ERROR;
+        if (isTridiagonalDominant(sub, diag, super, n))
+        {
+            status = thomasSolve(sub, diag, super, b, x, n);
+        }
+        free(sub);
+        free(diag);
+        free(super);
+        if (status == OK)
+        {
+            *solver = THOMAS_SOLVER;
+            return OK;
+        }
+    }
+
+    if (2 * *kl + *ku + 1 <= BAND_DENSITY_LIMIT * n || (*kl <= 1 && *ku <= 1))
+    {
+        double **B = toBandStorage(A, n, *kl, *ku);
+        int *ipiv = malloc(n * sizeof(int));
+        int status = bandedFactorize(B, n, *kl, *ku, ipiv);
+        if (status == OK)
+        {
+            memcpy(x, b, n * sizeof(double));
+            bandedSolve(B, n, *kl, *ku, ipiv, x);
+        }
+        freeMatrix(B, n);
+        free(ipiv);
+        *solver = BANDED_SOLVER;
+        return status;
+    }
+
+    *solver = DENSE_SOLVER;
+    return denseSolve(A, n, b, x);
+}
+
+// Function that request user to input Matrix elements
+void RequestInput(const char *name, double **matrix, int n)
+{
+    printf("Input Matrix %s Elements:\n", name);
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            printf("%s[%d][%d]=", name, i, j);
+            scanf("%lf", &matrix[i][j]);
+        }
+    }
+}
+
+// Function that request user to input Vector elements
+void RequestVectorInput(const char *name, double *vector, int n)
+{
+    printf("Input Vector %s Elements:\n", name);
+    for (int i = 0; i < n; i++)
+    {
+        printf("%s[%d]=", name, i);
+        scanf("%lf", &vector[i]);
+    }
+}
+
+int main()
+{
+    clock_t start_time, end_time;
+    int n;
+
+    // Step 1: Get dimensions for Matrix A
+    printf("\nChoose Matrix Dimension for the square matrix: ");
+    scanf("%d", &n);
+
+    // Error condition
+    if (n <= 0)
+    {
+        printf("Matrix Size can only be larger than zero, the program will exit...");
+        exit(1);
+    }
+
+    // Step 2: Allocate matrices memory
+    double **A = allocateMatrix(n, n);
+    double *b = malloc(n * sizeof(double));
+    double *x = malloc(n * sizeof(double));
+
+    // Note: You can either enter the matrix input manually, or choose to fill the matrices automatically. But make sure to comment "RequestInput" function calls, and to uncomment the alternative random input option.
+    // Step 3: Asking the user to input Matrix A and the right-hand side b
+    RequestInput("A", A, n);
+    RequestVectorInput("b", b, n);
+
+    // This is an alternative random input option (a finite-difference Laplacian), but make sure to comment "RequestInput" function calls.
+    /*for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            A[i][j] = (i == j) ? 2.0 : ((i - j == 1 || j - i == 1) ? -1.0 : 0.0);
+        }
+        b[i] = (double)rand() / RAND_MAX;
+    }*/
+
+    // Step 4: Detect the band structure and solve
+    int kl, ku, solver;
+    start_time = clock();
+    int status = solveSystem(A, n, b, x, &kl, &ku, &solver);
+    end_time = clock();
+
+    if (status != OK)
+    {
+        printf("Matrix is singular, the program will exit...");
+        exit(1);
+    }
+
+    // Step 5: Print results
+    const char *solver_names[] = {"Thomas tridiagonal", "Banded LU", "Dense LU"};
+    printf("\nLower bandwidth: %d, upper bandwidth: %d, solver used: %s\n", kl, ku, solver_names[solver]);
+    printf("Solution x:\n");
+    for (int i = 0; i < n; i++)
+    {
+        printf("%10.4f\n", x[i]);
+    }
+    printf("Time taken for the Banded Solver: %.6f seconds\n", (double)(end_time - start_time) / CLOCKS_PER_SEC);
+
+    // Step 6: Free memory
+    freeMatrix(A, n);
+    free(b);
+    free(x);
+
+    return 0;
+}
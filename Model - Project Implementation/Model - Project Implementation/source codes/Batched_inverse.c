@@ -0,0 +1,442 @@
+/*
+Group 03
+
+Hani Abdallah - 21400302
+Houssam Eddine Jamil Nasser - 21400407
+Tan Viet Nguyen - 21400381
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Matrices processed side by side, one per SIMD lane (8 doubles fill an AVX-512 register, two AVX2 registers)
+#define BATCH_LANES 8
+// Largest matrix of a batch, bounds the pivot bookkeeping kept on the stack
+#define BATCH_MAX_SIZE 64
+
+enum ERROR_CODES
+{
+    OK,
+    INCORRECT_MATRIX,
+    CALCULATION_ERROR
+};
+
+// A batch of count n x n matrices in an interleaved layout: the matrices are grouped BATCH_LANES at a time,
+// and inside a group element (i, j) of all lanes is stored contiguously, so element (i, j) of matrix g * BATCH_LANES + l
+// is data[((g * n + i) * n + j) * BATCH_LANES + l]
+// Every loop over the lanes is then a unit-stride vector operation, each lane working on a different matrix
+// Lanes of the last group that hold no matrix are kept as identities so they factorize without trouble
+typedef struct batched_matrices_struct
+{
+    double *data;
+    int n;
+    int count;
+    int groups;
+} batched_matrices_t;
+
+// Lanes of element (i, j) in the group starting at a
+#define LANES_AT(a, n, i, j) ((a) + ((size_t)(i) * (n) + (j)) * BATCH_LANES)
+
+// allocate memory for matrices
+double **allocateMatrix(int rows, int columns)
+{
+    double **matrix = (double **)malloc(rows * sizeof(double *));
+    for (int i = 0; i < rows; i++)
+    {
+        matrix[i] = (double *)malloc(columns * sizeof(double));
+    }
+    return matrix;
+}
+
+// free allocated memory of matrices
+void freeMatrix(double **matrix, int rows)
+{
+    for (int i = 0; i < rows; i++)
+    {
+        free(matrix[i]);
+    }
+    free(matrix);
+}
+
+// Function to print a matrix
+void printMatrix(const char *name, double **matrix, int n)
+{
+    printf("%s:\n", name);
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            printf("%10.4f ", matrix[i][j]);
+        }
+        printf("\n");
+    }
+}
+
+// One allocation for the whole batch, 64-byte aligned so every lane group starts on a cache line, filled with identities
+int createBatch(int n, int count, batched_matrices_t *batch)
+{
+    if (batch == NULL || n < 1 || n > BATCH_MAX_SIZE || count < 1)
+    {
+        return INCORRECT_MATRIX;
+    }
+
+    batch->n = n;
+    batch->count = count;
+    batch->groups = (count + BATCH_LANES - 1) / BATCH_LANES;
+    size_t bytes = (size_t)batch->groups * n * n * BATCH_LANES * sizeof(double);
+    batch->data = aligned_alloc(64, (bytes + 63) / 64 * 64);
+    if (batch->data == NULL)
+    {
+        return INCORRECT_MATRIX;
+    }
+
+    memset(batch->data, 0, bytes);
+    for (int g = 0; g < batch->groups; g++)
+    {
+        double *a = batch->data + (size_t)g * n * n * BATCH_LANES;
+        for (int i = 0; i < n; i++)
+        {
+            for (int l = 0; l < BATCH_LANES; l++)
+            {
+                LANES_AT(a, n, i, i)[l] = 1.0;
+            }
+        }
+    }
+    return OK;
+}
+
+void freeBatch(batched_matrices_t *batch)
+{
+    if (batch != NULL)
+    {
+        free(batch->data);
+        batch->data = NULL;
+    }
+}
+
+// Copy matrix A into slot index of the batch
+void setBatchMatrix(batched_matrices_t *batch, int index, double **A)
+{
+    int n = batch->n;
+    double *a = batch->data + (size_t)(index / BATCH_LANES) * n * n * BATCH_LANES;
+    int l = index % BATCH_LANES;
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            LANES_AT(a, n, i, j)[l] = A[i][j];
+        }
+    }
+}
+
+// Copy slot index of the batch into matrix A
+void getBatchMatrix(batched_matrices_t *batch, int index, double **A)
+{
+    int n = batch->n;
+    double *a = batch->data + (size_t)(index / BATCH_LANES) * n * n * BATCH_LANES;
+    int l = index % BATCH_LANES;
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            A[i][j] = LANES_AT(a, n, i, j)[l];
+        }
+    }
+}
+
+// Partial pivoting for step k in every lane: pivot[l] is the row of the largest |a(i, k)|, i >= k, and the rows are
+// swapped in that lane only; a zero pivot marks the matrix as singular and 1 is used in its place to keep the lane finite
+// Returns 1 / pivot for every lane in reciprocal
+void pivotLanes(double *a, int n, int k, int *pivot, double *reciprocal, int *status, int first_matrix, int count)
+{
+    for (int l = 0; l < BATCH_LANES; l++)
+    {
+        int p = k;
+        for (int i = k + 1; i < n; i++)
+        {
+            if (fabs(LANES_AT(a, n, i, k)[l]) > fabs(LANES_AT(a, n, p, k)[l]))
+            {
+                p = i;
+            }
+        }
+        pivot[l] = p;
+        if (p != k)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                double temp = LANES_AT(a, n, k, j)[l];
+                LANES_AT(a, n, k, j)[l] = LANES_AT(a, n, p, j)[l];
+                LANES_AT(a, n, p, j)[l] = temp;
+            }
+        }
+
+        double value = LANES_AT(a, n, k, k)[l];
+        if (value == 0.0)
+        {
+            if (first_matrix + l < count)
+            {
+                status[first_matrix + l] = CALCULATION_ERROR;
+            }
+            value = 1.0;
+        }
+        reciprocal[l] = 1.0 / value;
+    }
+}
+
+// Batched LU with partial pivoting in place: every matrix is overwritten by its L (unit diagonal, not stored) and U,
+// ipiv[m * n + k] is the row swapped with row k of matrix m, status[m] is OK or CALCULATION_ERROR for a singular matrix
+// Groups are spread over the threads, the elimination inside a group runs across the lanes; nothing is allocated
+int batchedLU(batched_matrices_t *batch, int *ipiv, int *status)
+{
+    if (batch == NULL || batch->data == NULL || ipiv == NULL || status == NULL)
+    {
+        return INCORRECT_MATRIX;
+    }
+
+    int n = batch->n;
+    int count = batch->count;
+    for (int m = 0; m < count; m++)
+    {
+        status[m] = OK;
+    }
+
+#pragma omp parallel for schedule(static)
+    for (int g = 0; g < batch->groups; g++)
+    {
+        double *a = batch->data + (size_t)g * n * n * BATCH_LANES;
+        int first_matrix = g * BATCH_LANES;
+        int pivot[BATCH_LANES];
+        double reciprocal[BATCH_LANES];
+        double factor[BATCH_LANES];
+
+        for (int k = 0; k < n; k++)
+        {
+            pivotLanes(a, n, k, pivot, reciprocal, status, first_matrix, count);
+            for (int l = 0; l < BATCH_LANES && first_matrix + l < count; l++)
+            {
+                ipiv[(first_matrix + l) * n + k] = pivot[l];
+            }
+
+            // Rows below the pivot: multipliers into L, then the trailing update, each one vector operation over the lanes
+            for (int i = k + 1; i < n; i++)
+            {
+                double *row_i = LANES_AT(a, n, i, 0);
+                double *row_k = LANES_AT(a, n, k, 0);
+#pragma omp simd
+                for (int l = 0; l < BATCH_LANES; l++)
+                {
+                    factor[l] = row_i[k * BATCH_LANES + l] * reciprocal[l];
+                    row_i[k * BATCH_LANES + l] = factor[l];
+                }
+                for (int j = k + 1; j < n; j++)
+                {
+#pragma omp simd
+                    for (int l = 0; l < BATCH_LANES; l++)
+                    {
+                        row_i[j * BATCH_LANES + l] -= factor[l] * row_k[j * BATCH_LANES + l];
+                    }
+                }
+            }
+        }
+    }
+    return OK;
+}
+
+// Batched in-place Gauss-Jordan inversion with partial pivoting: every matrix is overwritten by its inverse,
+// status[m] is OK or CALCULATION_ERROR for a singular matrix (its slot then holds no meaningful values)
+// The row interchanges of each lane are undone at the end as column interchanges in reverse order
+int batchedInverse(batched_matrices_t *batch, int *status)
+{
+    if (batch == NULL || batch->data == NULL || status == NULL)
+    {
+        return INCORRECT_MATRIX;
+    }
+
+    int n = batch->n;
+    int count = batch->count;
+    for (int m = 0; m < count; m++)
+    {
+        status[m] = OK;
+    }
+
+#pragma omp parallel for schedule(static)
+    for (int g = 0; g < batch->groups; g++)
+    {
+        double *a = batch->data + (size_t)g * n * n * BATCH_LANES;
+        int first_matrix = g * BATCH_LANES;
+        int pivots[BATCH_MAX_SIZE][BATCH_LANES];
+        double reciprocal[BATCH_LANES];
+        double factor[BATCH_LANES];
+
+        for (int k = 0; k < n; k++)
+        {
+            pivotLanes(a, n, k, pivots[k], reciprocal, status, first_matrix, count);
+
+            // Scale the pivot row, the pivot position keeps the matching entry of the inverse
+            double *row_k = LANES_AT(a, n, k, 0);
+#pragma omp simd
+            for (int l = 0; l < BATCH_LANES; l++)
+            {
+                row_k[k * BATCH_LANES + l] = 1.0;
+            }
+            for (int j = 0; j < n; j++)
+            {
+#pragma omp simd
+                for (int l = 0; l < BATCH_LANES; l++)
+                {
+                    row_k[j * BATCH_LANES + l] *= reciprocal[l];
+                }
+            }
+
+            // Eliminate column k from every other row
+            for (int i = 0; i < n; i++)
+            {
+                if (i == k)
+                {
+                    continue;
+                }
+                double *row_i = LANES_AT(a, n, i, 0);
+#pragma omp simd
+                for (int l = 0; l < BATCH_LANES; l++)
+                {
+                    factor[l] = row_i[k * BATCH_LANES + l];
+                    row_i[k * BATCH_LANES + l] = 0.0;
+                }
+                for (int j = 0; j < n; j++)
+                {
+#pragma omp simd
+                    for (int l = 0; l < BATCH_LANES; l++)
+                    {
+                        row_i[j * BATCH_LANES + l] -= factor[l] * row_k[j * BATCH_LANES + l];
+                    }
+                }
+            }
+        }
+
+        // Undo the row interchanges: swap the matching columns, last interchange first
+        for (int k = n - 1; k >= 0; k--)
+        {
+            for (int l = 0; l < BATCH_LANES; l++)
+            {
+                int p = pivots[k][l];
+                if (p != k)
+                {
+                    for (int i = 0; i < n; i++)
+                    {
+                        double temp = LANES_AT(a, n, i, k)[l];
+                        LANES_AT(a, n, i, k)[l] = LANES_AT(a, n, i, p)[l];
+                        LANES_AT(a, n, i, p)[l] = temp;
+                    }
+                }
+            }
+        }
+    }
+    return OK;
+}
+
+// Function that request user to input Matrix elements
+void RequestInput(const char *name, double **matrix, int n)
+{
+    printf("Input Matrix %s Elements:\n", name);
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            printf("%s[%d][%d]=", name, i, j);
+            scanf("%lf", &matrix[i][j]);
+        }
+    }
+}
+
+int main()
+{
+    int n, count;
+
+    // Step 1: Get dimensions for the matrices and the size of the batch
+    printf("\nChoose Matrix Dimension for the square matrix: ");
+    scanf("%d", &n);
+    printf("\nChoose the number of matrices in the batch: ");
+    scanf("%d", &count);
+
+    // Error condition 1
+    if (n <= 0 || count <= 0)
+    {
+        printf("Matrix Size and batch size can only be larger than zero, the program will exit...");
+        exit(1);
+    }
+
+    // Error condition 2
+    if (n > BATCH_MAX_SIZE)
+    {
+        printf("Matrix Size can be at most %d for a batch, the program will exit...", BATCH_MAX_SIZE);
+        exit(1);
+    }
+
+    // Step 2: Allocate the batch and one matrix used to fill and read it
+    batched_matrices_t batch;
+    if (createBatch(n, count, &batch) != OK)
+    {
+        printf("Batch could not be allocated, the program will exit...");
+        exit(1);
+    }
+    double **A = allocateMatrix(n, n);
+    int *status = malloc(count * sizeof(int));
+    char name[32];
+
+    // Note: You can either enter the matrix input manually, or choose to fill the matrices automatically. But make sure to comment "RequestInput" function calls, and to uncomment the alternative random input option.
+    // Step 3: Asking the user to input the elements of every matrix of the batch
+    for (int m = 0; m < count; m++)
+    {
+        snprintf(name, sizeof(name), "A%d", m);
+        RequestInput(name, A, n);
+
+        // This is an alternative random input option, but make sure to comment "RequestInput" function calls.
+        /*for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                A[i][j] = (i == j) ? n : ((double)rand() / RAND_MAX);
+            }
+        }*/
+
+        setBatchMatrix(&batch, m, A);
+    }
+
+    // Step 4: Invert the whole batch, timed on the wall clock since the work is spread over threads
+    struct timespec start_time, end_time;
+    timespec_get(&start_time, TIME_UTC);
+    batchedInverse(&batch, status);
+    timespec_get(&end_time, TIME_UTC);
+
+    // Step 5: Print results
+    for (int m = 0; m < count; m++)
+    {
+        snprintf(name, sizeof(name), "Matrix A%d inverse", m);
+        if (status[m] != OK)
+        {
+            printf("%s: matrix is singular\n", name);
+            continue;
+        }
+        getBatchMatrix(&batch, m, A);
+        printMatrix(name, A, n);
+    }
+#ifdef _OPENMP
+    printf("Threads used: %d\n", omp_get_max_threads());
+#endif
+    printf("Time taken for the batched inversion of %d matrices: %.6f seconds\n", count,
+           (double)(end_time.tv_sec - start_time.tv_sec) + (double)(end_time.tv_nsec - start_time.tv_nsec) / 1e9);
+
+    // Step 6: Free memory
+    freeBatch(&batch);
+    freeMatrix(A, n);
+    free(status);
+
+    return 0;
+}
@@ -0,0 +1,310 @@
+/*
+Group 03
+
+Hani Abdallah - 21400302
+Houssam Eddine Jamil Nasser - 21400407
+Tan Viet Nguyen - 21400381
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+enum ERROR_CODES
+{
+    OK,
+    INCORRECT_MATRIX,
+    CALCULATION_ERROR
+};
+
+enum BATCH_MODES
+{
+    STRIDED_BATCH,
+    POINTER_BATCH
+};
+
+// Every matrix of a batch is one flat row-major block: element (i, j) of an m x n matrix is M[i * n + j]
+// Square products of the common sizes get their own kernel, any other shape uses the general one
+typedef void (*multiply_kernel_t)(const double *A, const double *B, double *C);
+
+// C = A * B for an m x k by k x n product, i-p-j order so the innermost loop runs along rows of B and C
+void multiply_general(const double *A, const double *B, double *C, int m, int k, int n)
+{
+    for (int i = 0; i < m; i++)
+    {
+        double *row_C = C + (size_t)i * n;
+        for (int j = 0; j < n; j++)
+        {
+            row_C[j] = 0.0;
+        }
+        for (int p = 0; p < k; p++)
+        {
+            double a = A[(size_t)i * k + p];
+            const double *row_B = B + (size_t)p * n;
+            for (int j = 0; j < n; j++)
+            {
+                row_C[j] += a * row_B[j];
+            }
+        }
+    }
+}
+
+// Same loops with N a compile-time constant in every caller: after inlining the trip counts are known,
+// so the compiler unrolls them and vectorizes the row updates without remainder handling
+static inline void multiply_fixed(const double *A, const double *B, double *C, const int N)
+{
+    for (int i = 0; i < N; i++)
+    {
+        double row_C[N];
+        for (int j = 0; j < N; j++)
+        {
+            row_C[j] = 0.0;
+        }
+        for (int p = 0; p < N; p++)
+        {
+            double a = A[i * N + p];
+            for (int j = 0; j < N; j++)
+            {
+                row_C[j] += a * B[p * N + j];
+            }
+        }
+        memcpy(C + i * N, row_C, N * sizeof(double));
+    }
+}
+
+void multiply_4x4(const double *A, const double *B, double *C)
+{
+    multiply_fixed(A, B, C, 4);
+}
+
+void multiply_8x8(const double *A, const double *B, double *C)
+{
+    multiply_fixed(A, B, C, 8);
+}
+
+void multiply_16x16(const double *A, const double *B, double *C)
+{
+    multiply_fixed(A, B, C, 16);
+}
+
+void multiply_32x32(const double *A, const double *B, double *C)
+{
+    multiply_fixed(A, B, C, 32);
+}
+
+void multiply_64x64(const double *A, const double *B, double *C)
+{
+    multiply_fixed(A, B, C, 64);
+}
+
+// Fixed-size kernel for an m x k by k x n product, NULL when the general kernel has to be used
+multiply_kernel_t selectKernel(int m, int k, int n)
+{
+    if (m != k || k != n)
+    {
+        return NULL;
+    }
+    switch (n)
+    {
+    case 4:
+        return multiply_4x4;
+    case 8:
+        return multiply_8x8;
+    case 16:
+        return multiply_16x16;
+    case 32:
+        return multiply_32x32;
+    case 64:
+        return multiply_64x64;
+    default:
+        return NULL;
+    }
+}
+
+// Strided batch: product b reads A + b * stride_A and B + b * stride_B and writes C + b * stride_C
+// A stride of 0 reuses the same matrix for the whole batch (for example one B applied to many A)
+// The kernel is chosen once for the batch, the products are split over the threads, nothing is allocated
+int batchedMultiplyStrided(const double *A, long stride_A, const double *B, long stride_B, double *C, long stride_C,
+                           int m, int k, int n, int count)
+{
+    if (A == NULL || B == NULL || C == NULL || m < 1 || k < 1 || n < 1 || count < 0)
+    {
+        return INCORRECT_MATRIX;
+    }
+
+    multiply_kernel_t kernel = selectKernel(m, k, n);
+
+#pragma omp parallel for schedule(static)
+    for (int b = 0; b < count; b++)
+    {
+        const double *A_b = A + (size_t)b * stride_A;
+        const double *B_b = B + (size_t)b * stride_B;
+        double *C_b = C + (size_t)b * stride_C;
+        if (kernel != NULL)
+        {
+            kernel(A_b, B_b, C_b);
+        }
+        else
+        {
+            multiply_general(A_b, B_b, C_b, m, k, n);
+        }
+    }
+    return OK;
+}
+
+// Pointer-array batch: C[b] = A[b] * B[b], for matrices that do not sit at a fixed stride from each other
+int batchedMultiplyPointers(const double **A, const double **B, double **C, int m, int k, int n, int count)
+{
+    if (A == NULL || B == NULL || C == NULL || m < 1 || k < 1 || n < 1 || count < 0)
+    {
+        return INCORRECT_MATRIX;
+    }
+
+    multiply_kernel_t kernel = selectKernel(m, k, n);
+
+#pragma omp parallel for schedule(static)
+    for (int b = 0; b < count; b++)
+    {
+        if (kernel != NULL)
+        {
+            kernel(A[b], B[b], C[b]);
+        }
+        else
+        {
+            multiply_general(A[b], B[b], C[b], m, k, n);
+        }
+    }
+    return OK;
+}
+
+// Function to print a flat matrix
+void printFlatMatrix(const char *name, const double *matrix, int rows, int columns)
+{
+    printf("%s:\n", name);
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < columns; j++)
+        {
+            printf("%10.4f ", matrix[i * columns + j]);
+        }
+        printf("\n");
+    }
+}
+
+// Function that request user to input the elements of a flat matrix
+void RequestInput(const char *name, double *matrix, int rows, int columns)
+{
+    printf("Input Matrix %s Elements:\n", name);
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < columns; j++)
+        {
+            printf("%s[%d][%d]=", name, i, j);
+            scanf("%lf", &matrix[i * columns + j]);
+        }
+    }
+}
+
+int main()
+{
+    int n, count, mode;
+
+    // Step 1: Get dimensions for the matrices, the size of the batch and the batch layout
+    printf("\nChoose Matrix Dimension for the square matrix: ");
+    scanf("%d", &n);
+    printf("\nChoose the number of products in the batch: ");
+    scanf("%d", &count);
+    printf("\nChoose the batch layout (0: strided, 1: array of pointers): ");
+    scanf("%d", &mode);
+
+    // Error condition 1
+    if (n <= 0 || count <= 0)
+    {
+        printf("Matrix Size and batch size can only be larger than zero, the program will exit...");
+        exit(1);
+    }
+
+    // Error condition 2
+    if (mode != STRIDED_BATCH && mode != POINTER_BATCH)
+    {
+        printf("Batch layout can only be 0 or 1, the program will exit...");
+        exit(1);
+    }
+
+    // Step 2: Allocate the batches, one block each for all the A, B and C matrices
+    long stride = (long)n * n;
+    double *A = malloc((size_t)count * stride * sizeof(double));
+    double *B = malloc((size_t)count * stride * sizeof(double));
+    double *C = malloc((size_t)count * stride * sizeof(double));
+    char name[32];
+
+    // Note: You can either enter the matrix input manually, or choose to fill the matrices automatically. But make sure to comment "RequestInput" function calls, and to uncomment the alternative random input option.
+    // Step 3: Asking the user to input the elements of every pair of the batch
+    for (int b = 0; b < count; b++)
+    {
+        snprintf(name, sizeof(name), "A%d", b);
+        RequestInput(name, A + b * stride, n, n);
+        snprintf(name, sizeof(name), "B%d", b);
+        RequestInput(name, B + b * stride, n, n);
+    }
+
+    // This is an alternative random input option, but make sure to comment "RequestInput" function calls.
+    /*for (long i = 0; i < count * stride; i++)
+    {
+        A[i] = (double)rand() / RAND_MAX;
+        B[i] = (double)rand() / RAND_MAX;
+    }*/
+
+    // Step 4: Multiply the whole batch, timed on the wall clock since the work is spread over threads
+    struct timespec start_time, end_time;
+    if (mode == STRIDED_BATCH)
+    {
+        timespec_get(&start_time, TIME_UTC);
+        batchedMultiplyStrided(A, stride, B, stride, C, stride, n, n, n, count);
+        timespec_get(&end_time, TIME_UTC);
+    }
+    else
+    {
+        const double **A_array = malloc(count * sizeof(double *));
+        const double **B_array = malloc(count * sizeof(double *));
+        double **C_array = malloc(count * sizeof(double *));
+        for (int b = 0; b < count; b++)
+        {
+            A_array[b] = A + b * stride;
+            B_array[b] = B + b * stride;
+            C_array[b] = C + b * stride;
+        }
+
+        timespec_get(&start_time, TIME_UTC);
+        batchedMultiplyPointers(A_array, B_array, C_array, n, n, n, count);
+        timespec_get(&end_time, TIME_UTC);
+
+        free(A_array);
+        free(B_array);
+        free(C_array);
+    }
+
+    // Step 5: Print results
+    for (int b = 0; b < count; b++)
+    {
+        snprintf(name, sizeof(name), "Result C%d", b);
+        printFlatMatrix(name, C + b * stride, n, n);
+    }
+#ifdef _OPENMP
+    printf("Threads used: %d\n", omp_get_max_threads());
+#endif
+    printf("Time taken for the batched multiplication of %d products: %.6f seconds\n", count,
+           (double)(end_time.tv_sec - start_time.tv_sec) + (double)(end_time.tv_nsec - start_time.tv_nsec) / 1e9);
+
+    // Step 6: Free memory
+    free(A);
+    free(B);
+    free(C);
+
+    return 0;
+}
@@ -0,0 +1,733 @@
+/*
+Group 03
+
+Hani Abdallah - 21400302
+Houssam Eddine Jamil Nasser - 21400407
+Tan Viet Nguyen - 21400381
+
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// Below this size the kernels switch to plain loops, same cut-off as strassen_mult
+#define BASE_CASE_SIZE 64
+// Width of the panels of the blocked LU
+#define PANEL_SIZE 64
+
+// A leading block with ||A11^-1 * A12|| * ||A|| / ||A12|| above the limit is treated as a bad pivot block
+#define GROWTH_LIMIT 1e10
+// The elimination result is only accepted when ||A X - B|| <= limit * (||A|| * ||X|| + ||B||)
+#define RESIDUAL_LIMIT 1e-10
+
+enum ERROR_CODES
+{
+    OK,
+    INCORRECT_MATRIX,
+    CALCULATION_ERROR
+};
+
+enum SOLVE_METHODS
+{
+    BLOCKED_LU_SOLVE,
+    STRASSEN_ELIMINATION_SOLVE
+};
+
+// allocate memory for a rows x columns matrix
+double **allocate_matrix(int rows, int columns)
+{
+    double **matrix = (double **)malloc(rows * sizeof(double *));
+    for (int i = 0; i < rows; i++)
+    {
+        matrix[i] = (double *)malloc(columns * sizeof(double));
+    }
+    return matrix;
+}
+
+// free allocated memory of matrices
+void free_matrix(double **matrix, int rows)
+{
+    for (int i = 0; i < rows; i++)
+    {
+        free(matrix[i]);
+    }
+    free(matrix);
+}
+
+// Block of M starting at (row, column) seen as a matrix of its own, only the row pointers are allocated
+double **block_view(double **M, int row, int column, int rows)
+{
+    double **view = (double **)malloc(rows * sizeof(double *));
+    for (int i = 0; i < rows; i++)
+    {
+        view[i] = M[row + i] + column;
+    }
+    return view;
+}
+
+// Function to print a matrix
+void printMatrix(const char *name, double **matrix, int rows, int columns)
+{
+    printf("%s:\n", name);
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < columns; j++)
+        {
+            printf("%10.4f ", matrix[i][j]);
+        }
+        printf("\n");
+    }
+}
+
+// R = M * N with plain loops, M is m x k and N is k x n
+void nbasecase(double **M, double **N, double **R, int m, int k, int n)
+{
+    for (int i = 0; i < m; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            R[i][j] = 0.0;
+        }
+        for (int p = 0; p < k; p++)
+        {
+            double factor = M[i][p];
+            for (int j = 0; j < n; j++)
+            {
+                R[i][j] += factor * N[p][j];
+            }
+        }
+    }
+}
+
+// C = A + sign * B for rows x columns blocks
+void add_blocks(double **A, double **B, double **C, int rows, int columns, double sign)
+{
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < columns; j++)
+        {
+            C[i][j] = A[i][j] + sign * B[i][j];
+        }
+    }
+}
+
+// Strassen's algorithm for rectangular matrices (same as Triangular_inverse.c): R = M * N, M is m x k and N is k x n
+// The seven products of strassen_mult run on the even part of every dimension,
+// an odd last row, column or inner index is peeled off and fixed up with plain loops
+void strassen_mult_rect(double **M, double **N, double **R, int m, int k, int n)
+{
+    if (m <= BASE_CASE_SIZE || k <= BASE_CASE_SIZE || n <= BASE_CASE_SIZE)
+    {
+        nbasecase(M, N, R, m, k, n);
+        return;
+    }
+
+    int m2 = m / 2, k2 = k / 2, n2 = n / 2;
+
+    // M and N submatrices (Blocks), as views
+    double **a = block_view(M, 0, 0, m2);
+    double **b = block_view(M, 0, k2, m2);
+    double **c = block_view(M, m2, 0, m2);
+    double **d = block_view(M, m2, k2, m2);
+    double **x = block_view(N, 0, 0, k2);
+    double **y = block_view(N, 0, n2, k2);
+    double **z = block_view(N, k2, 0, k2);
+    double **t = block_view(N, k2, n2, k2);
+
+    double **q1 = allocate_matrix(m2, n2);
+    double **q2 = allocate_matrix(m2, n2);
+    double **q3 = allocate_matrix(m2, n2);
+    double **q4 = allocate_matrix(m2, n2);
+    double **q5 = allocate_matrix(m2, n2);
+    double **q6 = allocate_matrix(m2, n2);
+    double **q7 = allocate_matrix(m2, n2);
+    double **temp1 = allocate_matrix(m2, k2);
+    double **temp2 = allocate_matrix(k2, n2);
+
+    // q1 = a * (x + z)
+    add_blocks(x, z, temp2, k2, n2, 1.0);
+    strassen_mult_rect(a, temp2, q1, m2, k2, n2);
+
+    // q2 = d * (y + t)
+    add_blocks(y, t, temp2, k2, n2, 1.0);
+    strassen_mult_rect(d, temp2, q2, m2, k2, n2);
+
+    // q3 = (d - a) * (z - y)
+    add_blocks(d, a, temp1, m2, k2, -1.0);
+    add_blocks(z, y, temp2, k2, n2, -1.0);
+    strassen_mult_rect(temp1, temp2, q3, m2, k2, n2);
+
+    // q4 = (b - d) * (z + t)
+    add_blocks(b, d, temp1, m2, k2, -1.0);
+    add_blocks(z, t, temp2, k2, n2, 1.0);
+    strassen_mult_rect(temp1, temp2, q4, m2, k2, n2);
+
+    // q5 = (b - a) * z
+    add_blocks(b, a, temp1, m2, k2, -1.0);
+    strassen_mult_rect(temp1, z, q5, m2, k2, n2);
+
+    // q6 = (c - a) * (x + y)
+    add_blocks(c, a, temp1, m2, k2, -1.0);
+    add_blocks(x, y, temp2, k2, n2, 1.0);
+    strassen_mult_rect(temp1, temp2, q6, m2, k2, n2);
+
+    // q7 = (c - d) * y
+    add_blocks(c, d, temp1, m2, k2, -1.0);
+    strassen_mult_rect(temp1, y, q7, m2, k2, n2);
+
+    // result matrix R (even part)
+    for (int i = 0; i < m2; i++)
+    {
+        for (int j = 0; j < n2; j++)
+        {
+            R[i][j] = q1[i][j] + q5[i][j];
+            R[i][j + n2] = q2[i][j] + q3[i][j] + q4[i][j] - q5[i][j];
+            R[i + m2][j] = q1[i][j] + q3[i][j] + q6[i][j] - q7[i][j];
+            R[i + m2][j + n2] = q2[i][j] + q7[i][j];
+        }
+    }
+
+    // Peeling: odd inner dimension adds a rank-1 term to the even part
+    if (k % 2)
+    {
+        for (int i = 0; i < 2 * m2; i++)
+        {
+            double factor = M[i][k - 1];
+            for (int j = 0; j < 2 * n2; j++)
+            {
+                R[i][j] += factor * N[k - 1][j];
+            }
+        }
+    }
+    // Odd last column, then odd last row
+    if (n % 2)
+    {
+        for (int i = 0; i < m; i++)
+        {
+            double sum = 0.0;
+            for (int p = 0; p < k; p++)
+            {
+                sum += M[i][p] * N[p][n - 1];
+            }
+            R[i][n - 1] = sum;
+        }
+    }
+    if (m % 2)
+    {
+        for (int j = 0; j < 2 * n2; j++)
+        {
+            R[m - 1][j] = 0.0;
+        }
+        for (int p = 0; p < k; p++)
+        {
+            double factor = M[m - 1][p];
+            for (int j = 0; j < 2 * n2; j++)
+            {
+                R[m - 1][j] += factor * N[p][j];
+            }
+        }
+    }
+
+    //  free allocated memory
+    free(a);
+    free(b);
+    free(c);
+    free(d);
+    free(x);
+    free(y);
+    free(z);
+    free(t);
+    free_matrix(q1, m2);
+    free_matrix(q2, m2);
+    free_matrix(q3, m2);
+    free_matrix(q4, m2);
+    free_matrix(q5, m2);
+    free_matrix(q6, m2);
+    free_matrix(q7, m2);
+    free_matrix(temp1, m2);
+    free_matrix(temp2, k2);
+}
+
+// C += A * B through strassen_mult_rect, A is m x k and B is k x n
+void add_product(double **A, double **B, double **C, int m, int k, int n)
+{
+    double **product = allocate_matrix(m, n);
+    strassen_mult_rect(A, B, product, m, k, n);
+    add_blocks(C, product, C, m, n, 1.0);
+    free_matrix(product, m);
+}
+
+// C -= A * B through strassen_mult_rect, A is m x k and B is k x n
+void subtract_product(double **A, double **B, double **C, int m, int k, int n)
+{
+    double **product = allocate_matrix(m, n);
+    strassen_mult_rect(A, B, product, m, k, n);
+    add_blocks(C, product, C, m, n, -1.0);
+    free_matrix(product, m);
+}
+
+// infinity norm of a matrix (largest absolute row sum)
+double norm_inf(double **A, int rows, int columns)
+{
+    double norm = 0.0;
+    for (int i = 0; i < rows; i++)
+    {
+        double sum = 0.0;
+        for (int j = 0; j < columns; j++)
+        {
+            sum += fabs(A[i][j]);
+        }
+        if (sum > norm)
+        {
+            norm = sum;
+        }
+    }
+    return norm;
+}
+
+// Blocked right-looking LU with partial pivoting, LU overwrites A: P * A = L * U
+// Panels of PANEL_SIZE columns are factorized with plain loops, U12 = L11^-1 * A12 is a triangular solve,
+// and the trailing update A22 -= L21 * U12 goes through strassen_mult_rect
+// Row swaps exchange whole row pointers, perm[i] is the original row now in row i
+int blocked_lu(double **A, int n, int *perm)
+{
+    for (int i = 0; i < n; i++)
+    {
+        perm[i] = i;
+    }
+
+    for (int k = 0; k < n; k += PANEL_SIZE)
+    {
+        int b = (n - k < PANEL_SIZE) ? n - k : PANEL_SIZE;
+
+        // Step 1: panel factorization
+        for (int c = k; c < k + b; c++)
+        {
+            int pivot = c;
+            for (int i = c + 1; i < n; i++)
+            {
+                if (fabs(A[i][c]) > fabs(A[pivot][c]))
+                {
+                    pivot = i;
+                }
+            }
+            if (A[pivot][c] == 0.0)
+            {
+                return CALCULATION_ERROR;
+            }
+            if (pivot != c)
+            {
+                double *row = A[c];
+                A[c] = A[pivot];
+                A[pivot] = row;
+                int index = perm[c];
+                perm[c] = perm[pivot];
+                perm[pivot] = index;
+            }
+            for (int i = c + 1; i < n; i++)
+            {
+                double factor = A[i][c] / A[c][c];
+                A[i][c] = factor;
+                for (int j = c + 1; j < k + b; j++)
+                {
+                    A[i][j] -= factor * A[c][j];
+                }
+            }
+        }
+
+        int rest = n - k - b;
+        if (rest == 0)
+        {
+            break;
+        }
+
+        // Step 2: U12 = L11^-1 * A12
+        for (int i = k + 1; i < k + b; i++)
+        {
+            for (int p = k; p < i; p++)
+            {
+                double factor = A[i][p];
+                for (int j = k + b; j < n; j++)
+                {
+                    A[i][j] -= factor * A[p][j];
+                }
+            }
+        }
+
+        // Step 3: A22 -= L21 * U12
+        double **L21 = block_view(A, k + b, k, rest);
+        double **U12 = block_view(A, k, k + b, b);
+        double **A22 = block_view(A, k + b, k + b, rest);
+        subtract_product(L21, U12, A22, rest, b, rest);
+        free(L21);
+        free(U12);
+        free(A22);
+    }
+    return OK;
+}
+
+// X = U^-1 * L^-1 * P * B with the blocked LU factors, B is n x nrhs
+// Both triangular solves go block row by block row, the update from the solved blocks is one Strassen product
+void blocked_lu_solve(double **LU, int *perm, double **B, double **X, int n, int nrhs)
+{
+    for (int i = 0; i < n; i++)
+    {
+        memcpy(X[i], B[perm[i]], nrhs * sizeof(double));
+    }
+
+    // L Y = P B
+    for (int k = 0; k < n; k += PANEL_SIZE)
+    {
+        int b = (n - k < PANEL_SIZE) ? n - k : PANEL_SIZE;
+        double **Xk = block_view(X, k, 0, b);
+        if (k > 0)
+        {
+            double **L = block_view(LU, k, 0, b);
+            subtract_product(L, X, Xk, b, k, nrhs);
+            free(L);
+        }
+        for (int i = 1; i < b; i++)
+        {
+            for (int p = 0; p < i; p++)
+            {
+                double factor = LU[k + i][k + p];
+                for (int j = 0; j < nrhs; j++)
+                {
+                    Xk[i][j] -= factor * Xk[p][j];
+                }
+            }
+        }
+        free(Xk);
+    }
+
+    // U X = Y
+    int last = ((n - 1) / PANEL_SIZE) * PANEL_SIZE;
+    for (int k = last; k >= 0; k -= PANEL_SIZE)
+    {
+        int b = (n - k < PANEL_SIZE) ? n - k : PANEL_SIZE;
+        double **Xk = block_view(X, k, 0, b);
+        if (k + b < n)
+        {
+            double **U = block_view(LU, k, k + b, b);
+            double **X_below = block_view(X, k + b, 0, n - k - b);
+            subtract_product(U, X_below, Xk, b, n - k - b, nrhs);
+            free(U);
+            free(X_below);
+        }
+        for (int i = b - 1; i >= 0; i--)
+        {
+            for (int p = i + 1; p < b; p++)
+            {
+                double factor = LU[k + i][k + p];
+                for (int j = 0; j < nrhs; j++)
+                {
+                    Xk[i][j] -= factor * Xk[p][j];
+                }
+            }
+            for (int j = 0; j < nrhs; j++)
+            {
+                Xk[i][j] /= LU[k + i][k + i];
+            }
+        }
+        free(Xk);
+    }
+}
+
+// Strassen block elimination on the augmented system [A | B], A is n x n and B is n x m, both overwritten
+// [A11 A12 | B1; A21 A22 | B2]:
+//   [A11^-1 * A12 | A11^-1 * B1] by recursion on A11
+//   Schur complement [S | B2'] = [A22 | B2] - A21 * [A11^-1 * A12 | A11^-1 * B1] in one Strassen product
+//   X2 = S^-1 * B2' by recursion, then X1 = A11^-1 * B1 - (A11^-1 * A12) * X2
+// The solution is left in B; there is no pivoting across blocks, so a zero pivot in a leaf, or a leading block
+// whose solve grows past GROWTH_LIMIT relative to A, returns CALCULATION_ERROR
+int strassen_elimination(double **A, double **B, int n, int m)
+{
+    if (n <= BASE_CASE_SIZE)
+    {
+        // Leaf: Gaussian elimination with partial pivoting on [A | B]
+        for (int k = 0; k < n; k++)
+        {
+            int pivot = k;
+            for (int i = k + 1; i < n; i++)
+            {
+                if (fabs(A[i][k]) > fabs(A[pivot][k]))
+                {
+                    pivot = i;
+                }
+            }
+            if (A[pivot][k] == 0.0)
+            {
+                return CALCULATION_ERROR;
+            }
+            if (pivot != k)
+            {
+                double *row = A[k];
+                A[k] = A[pivot];
+                A[pivot] = row;
+                for (int j = 0; j < m; j++)
+                {
+                    double temp = B[k][j];
+                    B[k][j] = B[pivot][j];
+                    B[pivot][j] = temp;
+                }
+            }
+            for (int i = k + 1; i < n; i++)
+            {
+                double factor = A[i][k] / A[k][k];
+                for (int j = k + 1; j < n; j++)
+                {
+                    A[i][j] -= factor * A[k][j];
+                }
+                for (int j = 0; j < m; j++)
+                {
+                    B[i][j] -= factor * B[k][j];
+                }
+            }
+        }
+        for (int i = n - 1; i >= 0; i--)
+        {
+            for (int p = i + 1; p < n; p++)
+            {
+                for (int j = 0; j < m; j++)
+                {
+                    B[i][j] -= A[i][p] * B[p][j];
+                }
+            }
+            for (int j = 0; j < m; j++)
+            {
+                B[i][j] /= A[i][i];
+            }
+        }
+        return OK;
+    }
+
+    int n1 = (n + 1) / 2, n2 = n - n1;
+    double norm_A = norm_inf(A, n, n);
+    double **A12 = block_view(A, 0, n1, n1);
+    double norm_A12 = norm_inf(A12, n1, n2);
+    free(A12);
+
+    // Step 1: right-hand side [A12 | B1] for the leading block
+    double **A11 = allocate_matrix(n1, n1);
+    double **W = allocate_matrix(n1, n2 + m);
+    for (int i = 0; i < n1; i++)
+    {
+        memcpy(A11[i], A[i], n1 * sizeof(double));
+        memcpy(W[i], &A[i][n1], n2 * sizeof(double));
+        memcpy(&W[i][n2], B[i], m * sizeof(double));
+    }
+    int status = strassen_elimination(A11, W, n1, n2 + m);
+    free_matrix(A11, n1);
+
+    // A nearly singular A11 shows up as growth of A11^-1 * A12, which would swamp the Schur complement
+    if (status == OK && norm_inf(W, n1, n2) * norm_A > GROWTH_LIMIT * norm_A12)
+    {
+        status = CALCULATION_ERROR;
+    }
+
+    if (status == OK)
+    {
+        // Step 2: Schur complement on [A22 | B2]
+        double **A21 = block_view(A, n1, 0, n2);
+        double **T = allocate_matrix(n2, n2 + m);
+        for (int i = 0; i < n2; i++)
+        {
+            memcpy(T[i], &A[n1 + i][n1], n2 * sizeof(double));
+            memcpy(&T[i][n2], B[n1 + i], m * sizeof(double));
+        }
+        subtract_product(A21, W, T, n2, n1, n2 + m);
+        free(A21);
+
+        // Step 3: X2 from the Schur complement system
+        double **S = allocate_matrix(n2, n2);
+        double **X2 = allocate_matrix(n2, m);
+        for (int i = 0; i < n2; i++)
+        {
+            memcpy(S[i], T[i], n2 * sizeof(double));
+            memcpy(X2[i], &T[i][n2], m * sizeof(double));
+        }
+        status = strassen_elimination(S, X2, n2, m);
+
+        // Step 4: X1 = A11^-1 * B1 - (A11^-1 * A12) * X2
+        if (status == OK)
+        {
+            double **X1 = block_view(W, 0, n2, n1);
+            subtract_product(W, X2, X1, n1, n2, m);
+            for (int i = 0; i < n1; i++)
+            {
+                memcpy(B[i], X1[i], m * sizeof(double));
+            }
+            for (int i = 0; i < n2; i++)
+            {
+                memcpy(B[n1 + i], X2[i], m * sizeof(double));
+            }
+            free(X1);
+        }
+
+        free_matrix(T, n2);
+        free_matrix(S, n2);
+        free_matrix(X2, n2);
+    }
+
+    free_matrix(W, n1);
+    return status;
+}
+
+// Solve A X = B for nrhs right-hand sides without ever forming A^-1, A and B are left untouched
+// BLOCKED_LU_SOLVE: blocked LU with partial pivoting and blocked triangular solves
+// STRASSEN_ELIMINATION_SOLVE: recursive Schur complement on [A | B]; it cannot pivot across blocks,
+// so a zero pivot, a growing leading block or a residual above RESIDUAL_LIMIT makes it fall back to the
+// blocked LU (reported through method)
+int solve(double **A, double **B, double **X, int n, int nrhs, int *method)
+{
+    if (A == NULL || B == NULL || X == NULL || n < 1 || nrhs < 1)
+    {
+        return INCORRECT_MATRIX;
+    }
+
+    double **work = allocate_matrix(n, n);
+    for (int i = 0; i < n; i++)
+    {
+        memcpy(work[i], A[i], n * sizeof(double));
+    }
+    int status = CALCULATION_ERROR;
+
+    if (*method == STRASSEN_ELIMINATION_SOLVE)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            memcpy(X[i], B[i], nrhs * sizeof(double));
+        }
+        status = strassen_elimination(work, X, n, nrhs);
+        if (status == OK)
+        {
+            // R = B - A X, scaled as a normwise backward error
+            double **R = allocate_matrix(n, nrhs);
+            for (int i = 0; i < n; i++)
+            {
+                memcpy(R[i], B[i], nrhs * sizeof(double));
+            }
+            subtract_product(A, X, R, n, n, nrhs);
+            double scale = norm_inf(A, n, n) * norm_inf(X, n, nrhs) + norm_inf(B, n, nrhs);
+            if (!(norm_inf(R, n, nrhs) <= RESIDUAL_LIMIT * scale))
+            {
+                status = CALCULATION_ERROR;
+            }
+            free_matrix(R, n);
+        }
+        if (status != OK)
+        {
+            *method = BLOCKED_LU_SOLVE;
+            for (int i = 0; i < n; i++)
+            {
+                memcpy(work[i], A[i], n * sizeof(double));
+            }
+        }
+    }
+
+    if (*method == BLOCKED_LU_SOLVE)
+    {
+        int *perm = malloc(n * sizeof(int));
+        status = blocked_lu(work, n, perm);
+        if (status == OK)
+        {
+            blocked_lu_solve(work, perm, B, X, n, nrhs);
+        }
+        free(perm);
+    }
+
+    free_matrix(work, n);
+    return status;
+}
+
+// Function that request user to input Matrix elements
+void RequestInput(const char *name, double **matrix, int rows, int columns)
+{
+    printf("Input Matrix %s Elements:\n", name);
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < columns; j++)
+        {
+            printf("%s[%d][%d]=", name, i, j);
+            scanf("%lf", &matrix[i][j]);
+        }
+    }
+}
+
+int main()
+{
+    clock_t start_time, end_time;
+    int n, nrhs, method;
+
+    // Step 1: Get dimensions for Matrix A, the number of right-hand sides and the method
+    printf("\nChoose Matrix Dimension for the square matrix: ");
+    scanf("%d", &n);
+    printf("\nChoose the number of right-hand sides: ");
+    scanf("%d", &nrhs);
+    printf("\nChoose the method (0: blocked LU, 1: Strassen block elimination): ");
+    scanf("%d", &method);
+
+    // Error condition 1
+    if (n <= 0 || nrhs <= 0)
+    {
+        printf("Matrix Size can only be larger than zero, the program will exit...");
+        exit(1);
+    }
+
+    // Error condition 2
+    if (method != BLOCKED_LU_SOLVE && method != STRASSEN_ELIMINATION_SOLVE)
+    {
+        printf("Method can only be 0 or 1, the program will exit...");
+        exit(1);
+    }
+
+    // Step 2: Allocate matrices memory
+    double **A = allocate_matrix(n, n);
+    double **B = allocate_matrix(n, nrhs);
+    double **X = allocate_matrix(n, nrhs);
+
+    // Note: You can either enter the matrix input manually, or choose to fill the matrices automatically. But make sure to comment "RequestInput" function calls, and to uncomment the alternative random input option.
+    // Step 3: Asking the user to input Matrix A and the right-hand sides B (one per column)
+    RequestInput("A", A, n, n);
+    RequestInput("B", B, n, nrhs);
+
+    // This is an alternative random input option, but make sure to comment "RequestInput" function calls.
+    /*for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            A[i][j] = (i == j) ? n : ((double)rand() / RAND_MAX);
+        }
+        for (int j = 0; j < nrhs; j++)
+        {
+            B[i][j] = (double)rand() / RAND_MAX;
+        }
+    }*/
+
+    // Step 4: Solve A X = B
+    start_time = clock();
+    int status = solve(A, B, X, n, nrhs, &method);
+    end_time = clock();
+
+    // Error condition 3
+    if (status != OK)
+    {
+        printf("Matrix is singular, the program will exit...");
+        exit(1);
+    }
+
+    // Step 5: Print results
+    const char *method_names[] = {"blocked LU", "Strassen block elimination"};
+    printMatrix("Solution X", X, n, nrhs);
+    printf("\nMethod used: %s\n", method_names[method]);
+    printf("Time taken for the solve: %.6f seconds\n", (double)(end_time - start_time) / CLOCKS_PER_SEC);
+
+    // Step 6: Free memory
+    free_matrix(A, n);
+    free_matrix(B, n);
+    free_matrix(X, n);
+
+    return 0;
+}
@@ -0,0 +1,363 @@
+/*
+Group 03
+
+Hani Abdallah - 21400302
+Houssam Eddine Jamil Nasser - 21400407
+Tan Viet Nguyen - 21400381
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Width of the panels factorized by tournament pivoting
+#define PANEL_SIZE 64
+// Rows handled by one leaf of the tournament (never fewer than the panel width)
+#define CHUNK_ROWS 256
+
+enum ERROR_CODES
+{
+    OK,
+    INCORRECT_MATRIX,
+    CALCULATION_ERROR
+};
+
+// allocate memory for matrices
+double **allocateMatrix(int rows, int columns)
+{
+    double **matrix = (double **)malloc(rows * sizeof(double *));
+    for (int i = 0; i < rows; i++)
+    {
+        matrix[i] = (double *)malloc(columns * sizeof(double));
+    }
+    return matrix;
+}
+
+// free allocated memory of matrices
+void freeMatrix(double **matrix, int rows)
+{
+    for (int i = 0; i < rows; i++)
+    {
+        free(matrix[i]);
+    }
+    free(matrix);
+}
+
+// Gaussian elimination with partial pivoting on a count x b block made of the given candidate rows,
+// only used to choose pivots: the selected rows are written to the first min(count, b) entries of candidates
+int selectPivotRows(double **rows, int *candidates, int count, int col_start, int b)
+{
+    double **W = allocateMatrix(count, b);
+    for (int r = 0; r < count; r++)
+    {
+        memcpy(W[r], &rows[candidates[r]][col_start], b * sizeof(double));
+    }
+
+    int steps = (count < b) ? count : b;
+    for (int c = 0; c < steps; c++)
+    {
+        int pivot = c;
+        for (int r = c + 1; r < count; r++)
+        {
+            if (fabs(W[r][c]) > fabs(W[pivot][c]))
+            {
+                pivot = r;
+            }
+        }
+        if (pivot != c)
+        {
+            double *row = W[c];
+            W[c] = W[pivot];
+            W[pivot] = row;
+            int index = candidates[c];
+            candidates[c] = candidates[pivot];
+            candidates[pivot] = index;
+        }
+        if (W[c][c] == 0.0)
+        {
+            continue;
+        }
+        for (int r = c + 1; r < count; r++)
+        {
+            double factor = W[r][c] / W[c][c];
+            for (int j = c + 1; j < b; j++)
+            {
+                W[r][j] -= factor * W[c][j];
+            }
+        }
+    }
+
+    freeMatrix(W, count);
+    return steps;
+}
+
+// Tournament pivoting (TSLU) on the panel A[row_start .. m-1][col_start .. col_start+b-1]
+// Every chunk of rows proposes b candidates independently, then candidates play off pairwise
+// up a binary tree; only one reduction per level is needed instead of one per column
+// The b winning row indices are returned in winners
+void tournamentPivoting(double **A, int m, int row_start, int col_start, int b, int *winners)
+{
+    int rows = m - row_start;
+    int chunk_rows = (CHUNK_ROWS < b) ? b : CHUNK_ROWS;
+    int chunks = rows / chunk_rows;
+    if (chunks < 1)
+    {
+        chunks = 1;
+    }
+
+    // candidates[t] holds up to 2b row indices, count[t] the number of valid ones
+    int **candidates = malloc(chunks * sizeof(int *));
+    int *count = malloc(chunks * sizeof(int));
+
+    // Leaves: pivot selection on every chunk of rows
+#pragma omp parallel for schedule(dynamic)
+    for (int t = 0; t < chunks; t++)
+    {
+        int first = row_start + t * chunk_rows;
+        int last = (t == chunks - 1) ? m : first + chunk_rows;
+        int *leaf = malloc((last - first) * sizeof(int));
+        for (int r = first; r < last; r++)
+        {
+            leaf[r - first] = r;
+        }
+        count[t] = selectPivotRows(A, leaf, last - first, col_start, b);
+        candidates[t] = malloc(2 * b * sizeof(int));
+        memcpy(candidates[t], leaf, count[t] * sizeof(int));
+        free(leaf);
+    }
+
+    // Reduction tree: at every level, pair t plays against pair t + stride
+    for (int stride = 1; stride < chunks; stride *= 2)
+    {
+#pragma omp parallel for schedule(dynamic)
+        for (int t = 0; t < chunks - stride; t += 2 * stride)
+        {
+            memcpy(&candidates[t][count[t]], candidates[t + stride], count[t + stride] * sizeof(int));
+            count[t] = selectPivotRows(A, candidates[t], count[t] + count[t + stride], col_start, b);
+        }
+    }
+
+    memcpy(winners, candidates[0], b * sizeof(int));
+
+    for (int t = 0; t < chunks; t++)
+    {
+        free(candidates[t]);
+    }
+    free(candidates);
+    free(count);
+}
+
+// Communication-avoiding LU (CALU) of an m x n matrix with m >= n: P * A = L * U
+// A is factorized in place (L below the diagonal, U on and above it), perm[i] is the original row now in row i
+// Row interchanges swap whole row pointers, so they reach the L part on the left for free
+int CALU_Decomposition(double **A, int m, int n, int *perm)
+{
+    if (A == NULL || perm == NULL || m < 1 || n < 1 || m < n)
+    {
+        return INCORRECT_MATRIX;
+    }
+
+    int status = OK;
+    int *winners = malloc(PANEL_SIZE * sizeof(int));
+    double **original_rows = malloc(m * sizeof(double *));
+    for (int i = 0; i < m; i++)
+    {
+        perm[i] = i;
+    }
+
+    for (int k = 0; k < n && status == OK; k += PANEL_SIZE)
+    {
+        int b = (n - k < PANEL_SIZE) ? n - k : PANEL_SIZE;
+
+        // Step 1: choose the b pivot rows of the panel by tournament
+        tournamentPivoting(A, m, k, k, b, winners);
+
+        // Step 2: move the winners on top of the panel, winners are looked up by row pointer
+        // since every swap moves row pointers around
+        for (int c = 0; c < b; c++)
+        {
+            original_rows[c] = A[winners[c]];
+        }
+        for (int c = 0; c < b; c++)
+        {
+            int position = k + c;
+            while (A[position] != original_rows[c])
+            {
+                position++;
+            }
+            double *row = A[k + c];
+            A[k + c] = A[position];
+            A[position] = row;
+            int index = perm[k + c];
+            perm[k + c] = perm[position];
+            perm[position] = index;
+        }
+
+        // Step 3: LU of the panel without further pivoting
+        for (int c = k; c < k + b; c++)
+        {
+            if (A[c][c] == 0.0)
+            {
+                status = CALCULATION_ERROR;
+                break;
+            }
+#pragma omp parallel for schedule(static)
+            for (int r = c + 1; r < m; r++)
+            {
+                double factor = A[r][c] / A[c][c];
+                A[r][c] = factor;
+                for (int j = c + 1; j < k + b; j++)
+                {
+                    A[r][j] -= factor * A[c][j];
+                }
+            }
+        }
+        if (status != OK)
+        {
+            break;
+        }
+
+        // Step 4: U12 = L11^-1 * A12
+        for (int i = k + 1; i < k + b; i++)
+        {
+            for (int p = k; p < i; p++)
+            {
+                double factor = A[i][p];
+                for (int j = k + b; j < n; j++)
+                {
+                    A[i][j] -= factor * A[p][j];
+                }
+            }
+        }
+
+        // Step 5: trailing update A22 -= L21 * U12, rows are independent
+#pragma omp parallel for schedule(static)
+        for (int i = k + b; i < m; i++)
+        {
+            for (int p = k; p < k + b; p++)
+            {
+                double factor = A[i][p];
+                for (int j = k + b; j < n; j++)
+                {
+                    A[i][j] -= factor * A[p][j];
+                }
+            }
+        }
+    }
+
+    free(winners);
+    free(original_rows);
+    return status;
+}
+
+// Function that request user to input Matrix elements
+void RequestInput(const char *name, double **matrix, int rows, int columns)
+{
+    printf("Input Matrix %s Elements:\n", name);
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < columns; j++)
+        {
+            printf("%s[%d][%d]=", name, i, j);
+            scanf("%lf", &matrix[i][j]);
+        }
+    }
+}
+
+int main()
+{
+    int rows, columns;
+
+    // Step 1: Get dimensions for Matrix A
+    printf("\nChoose the number of rows of Matrix A: ");
+    scanf("%d", &rows);
+    printf("\nChoose the number of columns of Matrix A: ");
+    scanf("%d", &columns);
+
+    // Error condition 1
+    if (rows <= 0 || columns <= 0)
+    {
+        printf("Matrix Size can only be larger than zero, the program will exit...");
+        exit(1);
+    }
+
+    // Error condition 2
+    if (rows < columns)
+    {
+        printf("Matrix A must have at least as many rows as columns, the program will exit...");
+        exit(1);
+    }
+
+    // Step 2: Allocate matrices memory
+    double **A = allocateMatrix(rows, columns);
+    int *perm = malloc(rows * sizeof(int));
+
+    // Note: You can either enter the matrix input manually, or choose to fill the matrices automatically. But make sure to comment "RequestInput" function calls, and to uncomment the alternative random input option.
+    // Step 3: Asking the user to input Matrix A elements
+    RequestInput("A", A, rows, columns);
+
+    // This is an alternative random input option, but make sure to comment "RequestInput" function calls.
+    /*for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < columns; j++)
+        {
+            A[i][j] = (double)rand() / RAND_MAX;
+        }
+    }*/
+
+    // Step 4: Perform CALU in place, timed on the wall clock since the work is spread over threads
+    struct timespec start_time, end_time;
+    timespec_get(&start_time, TIME_UTC);
+    int status = CALU_Decomposition(A, rows, columns, perm);
+    timespec_get(&end_time, TIME_UTC);
+
+    if (status != OK)
+    {
+        printf("Matrix does not have full column rank, the program will exit...");
+        exit(1);
+    }
+
+#ifdef _OPENMP
+    printf("Threads used: %d\n", omp_get_max_threads());
+#endif
+    printf("Time taken for CALU Decomposition Algorithm: %.6f seconds\n",
+           (double)(end_time.tv_sec - start_time.tv_sec) + (double)(end_time.tv_nsec - start_time.tv_nsec) / 1e9);
+
+    // Step 5: Print results
+    printf("\nLower Trapezoidal Matrix (L):\n");
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < columns; j++)
+        {
+            printf("%.3f\t", (j < i) ? A[i][j] : ((i == j) ? 1.0 : 0.0));
+        }
+        printf("\n");
+    }
+    printf("\nUpper Triangular Matrix (U):\n");
+    for (int i = 0; i < columns; i++)
+    {
+        for (int j = 0; j < columns; j++)
+        {
+            printf("%.3f\t", (j >= i) ? A[i][j] : 0.0);
+        }
+        printf("\n");
+    }
+    printf("\nRow order of P * A: ");
+    for (int i = 0; i < rows; i++)
+    {
+        printf("%d ", perm[i]);
+    }
+    printf("\n");
+
+    // Step 6: Free memory
+    freeMatrix(A, rows);
+    free(perm);
+
+    return 0;
+}
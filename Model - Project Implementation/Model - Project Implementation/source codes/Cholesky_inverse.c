@@ -0,0 +1,620 @@
+/*
+Group 03
+
+Hani Abdallah - 21400302
+Houssam Eddine Jamil Nasser - 21400407
+Tan Viet Nguyen - 21400381
+
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// Tiles are TILE_SIZE x TILE_SIZE, a power of two so that tile products can go through strassen_mult
+#define TILE_SIZE 128
+
+enum ERROR_CODES
+{
+    OK,
+    INCORRECT_MATRIX,
+    CALCULATION_ERROR
+};
+
+// Symmetric matrix stored as its lower triangle of tiles only: tile (I, J) with J <= I
+// Edge tiles are zero padded, diagonal tiles keep zeros above their diagonal
+typedef struct lower_tiles_struct
+{
+    double ***tiles;
+    int n;
+    int nt;
+} lower_tiles_t;
+
+#define TILE(T, I, J) ((T)->tiles[(I) * ((I) + 1) / 2 + (J)])
+
+// allocate memory for matrices
+double **allocate_matrix(int size)
+{
+    double **matrix = (double **)malloc(size * sizeof(double *));
+    for (int i = 0; i < size; i++)
+    {
+        matrix[i] = (double *)malloc(size * sizeof(double));
+    }
+    return matrix;
+}
+
+// free allocated memory of matrices
+void free_matrix(double **matrix, int size)
+{
+    for (int i = 0; i < size; i++)
+    {
+        free(matrix[i]);
+    }
+    free(matrix);
+}
+
+// subtraction of two matrices
+void subtract_matrix(double **A, double **B, double **C, int size)
+{
+    for (int i = 0; i < size; i++)
+    {
+        for (int j = 0; j < size; j++)
+        {
+            C[i][j] = A[i][j] - B[i][j];
+        }
+    }
+}
+
+// addition of two matrices
+void add_matrix(double **A, double **B, double **C, int size)
+{
+    for (int i = 0; i < size; i++)
+    {
+        for (int j = 0; j < size; j++)
+        {
+            C[i][j] = A[i][j] + B[i][j];
+        }
+    }
+}
+
+void nbasecase(double **A, double **B, double **result_matrix, int size)
+{
+    for (int i = 0; i < size; i++)
+    {
+        for (int j = 0; j < size; j++)
+        {
+            result_matrix[i][j] = 0.0;
+            for (int k = 0; k < size; k++)
+            {
+                result_matrix[i][j] += A[i][k] * B[k][j];
+            }
+        }
+    }
+}
+
+// Function to print a matrix
+void printMatrix(const char *name, double **matrix, int n)
+{
+    printf("%s:\n", name);
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            printf("%10.4f ", matrix[i][j]);
+        }
+        printf("\n");
+    }
+}
+
+// Strassen's algorithm (same as Strassen_inverse_using_strassen_multiplication.c), size is a power of two
+void strassen_mult(double **M, double **N, double **R, int size)
+{
+    if (size <= 64)
+    {
+        nbasecase(M, N, R, size);
+        return;
+    }
+
+    int newSize = size / 2;
+
+    // submatrices allocation
+    double **a = allocate_matrix(newSize);
+    double **b = allocate_matrix(newSize);
+    double **c = allocate_matrix(newSize);
+    double **d = allocate_matrix(newSize);
+    double **x = allocate_matrix(newSize);
+    double **y = allocate_matrix(newSize);
+    double **z = allocate_matrix(newSize);
+    double **t = allocate_matrix(newSize);
+    double **q1 = allocate_matrix(newSize);
+    double **q2 = allocate_matrix(newSize);
+    double **q3 = allocate_matrix(newSize);
+    double **q4 = allocate_matrix(newSize);
+    double **q5 = allocate_matrix(newSize);
+    double **q6 = allocate_matrix(newSize);
+    double **q7 = allocate_matrix(newSize);
+
+    double **temp1 = allocate_matrix(newSize);
+    double **temp2 = allocate_matrix(newSize);
+
+    // M and N submatrices (Blocks)
+    for (int i = 0; i < newSize; i++)
+    {
+        for (int j = 0; j < newSize; j++)
+        {
+            a[i][j] = M[i][j];                     // M11
+            b[i][j] = M[i][j + newSize];           // M12
+            c[i][j] = M[i + newSize][j];           // M21
+            d[i][j] = M[i + newSize][j + newSize]; // M22
+            x[i][j] = N[i][j];                     // N11
+            y[i][j] = N[i][j + newSize];           // N12
+            z[i][j] = N[i + newSize][j];           // N21
+            t[i][j] = N[i + newSize][j + newSize]; // N22
+        }
+    }
+
+    // q1 = a * (x + z)
+    add_matrix(x, z, temp2, newSize);
+    strassen_mult(a, temp2, q1, newSize);
+
+    // q2 = d * (y + t)
+    add_matrix(y, t, temp2, newSize);
+    strassen_mult(d, temp2, q2, newSize);
+
+    // q3 = (d - a) * (z - y)
+    subtract_matrix(d, a, temp1, newSize);
+    subtract_matrix(z, y, temp2, newSize);
+    strassen_mult(temp1, temp2, q3, newSize);
+
+    // q4 = (b - d) * (z + t)
+    subtract_matrix(b, d, temp1, newSize);
+    add_matrix(z, t, temp2, newSize);
+    strassen_mult(temp1, temp2, q4, newSize);
+
+    // q5 = (b - a) * z
+    subtract_matrix(b, a, temp1, newSize);
+    strassen_mult(temp1, z, q5, newSize);
+
+    // q6 = (c - a) * (x + y)
+    subtract_matrix(c, a, temp1, newSize);
+    add_matrix(x, y, temp2, newSize);
+    strassen_mult(temp1, temp2, q6, newSize);
+
+    // q7 = (c - d) * y
+    subtract_matrix(c, d, temp1, newSize);
+    strassen_mult(temp1, y, q7, newSize);
+
+    // result matrix R: r11 = q1 + q5, r12 = q2 + q3 + q4 - q5, r21 = q1 + q3 + q6 - q7, r22 = q2 + q7
+    for (int i = 0; i < newSize; i++)
+    {
+        for (int j = 0; j < newSize; j++)
+        {
+            R[i][j] = q1[i][j] + q5[i][j];
+            R[i][j + newSize] = q2[i][j] + q3[i][j] + q4[i][j] - q5[i][j];
+            R[i + newSize][j] = q1[i][j] + q3[i][j] + q6[i][j] - q7[i][j];
+            R[i + newSize][j + newSize] = q2[i][j] + q7[i][j];
+        }
+    }
+
+    //  free allocated memory
+    free_matrix(a, newSize);
+    free_matrix(b, newSize);
+    free_matrix(c, newSize);
+    free_matrix(d, newSize);
+    free_matrix(x, newSize);
+    free_matrix(y, newSize);
+    free_matrix(z, newSize);
+    free_matrix(t, newSize);
+    free_matrix(q1, newSize);
+    free_matrix(q2, newSize);
+    free_matrix(q3, newSize);
+    free_matrix(q4, newSize);
+    free_matrix(q5, newSize);
+    free_matrix(q6, newSize);
+    free_matrix(q7, newSize);
+    free_matrix(temp1, newSize);
+    free_matrix(temp2, newSize);
+}
+
+// Rows (or columns) of tile row I that belong to the matrix
+int tile_dimension(lower_tiles_t *T, int I)
+{
+    return (I == T->nt - 1) ? T->n - I * TILE_SIZE : TILE_SIZE;
+}
+
+// Copy the lower triangle of A into tiles, the upper triangle is never read
+void to_lower_tiles(double **A, int n, lower_tiles_t *T)
+{
+    T->n = n;
+    T->nt = (n + TILE_SIZE - 1) / TILE_SIZE;
+    T->tiles = malloc(T->nt * (T->nt + 1) / 2 * sizeof(double **));
+    for (int I = 0; I < T->nt; I++)
+    {
+        for (int J = 0; J <= I; J++)
+        {
+            double **tile = allocate_matrix(TILE_SIZE);
+            for (int i = 0; i < TILE_SIZE; i++)
+            {
+                for (int j = 0; j < TILE_SIZE; j++)
+                {
+                    int row = I * TILE_SIZE + i;
+                    int column = J * TILE_SIZE + j;
+                    tile[i][j] = (row < n && column < n && column <= row) ? A[row][column] : 0.0;
+                }
+            }
+            TILE(T, I, J) = tile;
+        }
+    }
+}
+
+// Copy the tiles back into a full matrix, mirrored when symmetric is set, zero above the diagonal otherwise
+void from_lower_tiles(lower_tiles_t *T, double **A, int symmetric)
+{
+    for (int i = 0; i < T->n; i++)
+    {
+        for (int j = 0; j <= i; j++)
+        {
+            A[i][j] = TILE(T, i / TILE_SIZE, j / TILE_SIZE)[i % TILE_SIZE][j % TILE_SIZE];
+            A[j][i] = symmetric ? A[i][j] : ((i == j) ? A[i][j] : 0.0);
+        }
+    }
+}
+
+void free_lower_tiles(lower_tiles_t *T)
+{
+    for (int t = 0; t < T->nt * (T->nt + 1) / 2; t++)
+    {
+        free_matrix(T->tiles[t], TILE_SIZE);
+    }
+    free(T->tiles);
+}
+
+// C -= op(A) * op(B) with op(X) = X or X^T, the product goes through strassen_mult
+// Only the lower triangle of C is touched when lower_only is set (diagonal tiles)
+void subtract_tile_product(double **C, double **A, int transpose_A, double **B, int transpose_B, int lower_only)
+{
+    double **left = A;
+    double **right = B;
+    double **product = allocate_matrix(TILE_SIZE);
+    if (transpose_A)
+    {
+        left = allocate_matrix(TILE_SIZE);
+        for (int i = 0; i < TILE_SIZE; i++)
+        {
+            for (int j = 0; j < TILE_SIZE; j++)
+            {
+                left[i][j] = A[j][i];
+            }
+        }
+    }
+    if (transpose_B)
+    {
+        right = allocate_matrix(TILE_SIZE);
+        for (int i = 0; i < TILE_SIZE; i++)
+        {
+            for (int j = 0; j < TILE_SIZE; j++)
+            {
+                right[i][j] = B[j][i];
+            }
+        }
+    }
+
+    strassen_mult(left, right, product, TILE_SIZE);
+    for (int i = 0; i < TILE_SIZE; i++)
+    {
+        int last = lower_only ? i + 1 : TILE_SIZE;
+        for (int j = 0; j < last; j++)
+        {
+            C[i][j] -= product[i][j];
+        }
+    }
+
+    if (transpose_A)
+    {
+        free_matrix(left, TILE_SIZE);
+    }
+    if (transpose_B)
+    {
+        free_matrix(right, TILE_SIZE);
+    }
+    free_matrix(product, TILE_SIZE);
+}
+
+// Unblocked Cholesky of the m x m lower triangle of a diagonal tile
+// A pivot that is not positive proves A is not SPD, its global column is reported right away
+int cholesky_diagonal_tile(double **D, int m, int offset, int *failed_column)
+{
+    for (int j = 0; j < m; j++)
+    {
+        double pivot = D[j][j];
+        for (int p = 0; p < j; p++)
+        {
+            pivot -= D[j][p] * D[j][p];
+        }
+        if (!(pivot > 0.0))
+        {
+            *failed_column = offset + j;
+            return CALCULATION_ERROR;
+        }
+        D[j][j] = sqrt(pivot);
+        for (int i = j + 1; i < m; i++)
+        {
+            double sum = D[i][j];
+            for (int p = 0; p < j; p++)
+            {
+                sum -= D[i][p] * D[j][p];
+            }
+            D[i][j] = sum / D[j][j];
+        }
+    }
+    return OK;
+}
+
+// B = B * L^-T for the m x m lower triangular L of a diagonal tile
+void solve_against_diagonal_tile(double **B, double **L, int m)
+{
+    for (int r = 0; r < TILE_SIZE; r++)
+    {
+        for (int c = 0; c < m; c++)
+        {
+            double sum = B[r][c];
+            for (int p = 0; p < c; p++)
+            {
+                sum -= B[r][p] * L[c][p];
+            }
+            B[r][c] = sum / L[c][c];
+        }
+    }
+}
+
+// Right-looking tile Cholesky A = L * L^T, L overwrites the lower tiles
+// For every tile column: potrf on the diagonal tile, trsm below it, then the trailing
+// syrk / gemm updates A_ij -= L_ik * L_jk^T through Strassen's multiplication
+int cholesky_tiled(lower_tiles_t *T, int *failed_column)
+{
+    int nt = T->nt;
+    for (int k = 0; k < nt; k++)
+    {
+        if (cholesky_diagonal_tile(TILE(T, k, k), tile_dimension(T, k), k * TILE_SIZE, failed_column) != OK)
+        {
+            return CALCULATION_ERROR;
+        }
+        for (int i = k + 1; i < nt; i++)
+        {
+            solve_against_diagonal_tile(TILE(T, i, k), TILE(T, k, k), tile_dimension(T, k));
+        }
+        for (int i = k + 1; i < nt; i++)
+        {
+            for (int j = k + 1; j <= i; j++)
+            {
+                subtract_tile_product(TILE(T, i, j), TILE(T, i, k), 0, TILE(T, j, k), 1, i == j);
+            }
+        }
+    }
+    return OK;
+}
+
+// In-place inverse of the m x m lower triangle of a diagonal tile, column by column from the right
+void invert_lower_diagonal_tile(double **L, int m)
+{
+    for (int j = m - 1; j >= 0; j--)
+    {
+        L[j][j] = 1.0 / L[j][j];
+        for (int i = m - 1; i > j; i--)
+        {
+            // X_ij = -(sum_{p = j+1..i} X_ip * L_pj) * X_jj, X_ip (p > j) is already final
+            double sum = 0.0;
+            for (int p = j + 1; p <= i; p++)
+            {
+                sum += L[i][p] * L[p][j];
+            }
+            L[i][j] = -sum * L[j][j];
+        }
+    }
+}
+
+// POTRI on tiles: A^-1 = L^-T * L^-1, overwriting the Cholesky factor
+// TRTRI: X = L^-1 with X_IJ = -(sum_{K = J+1..I} X_IK * L_KJ) * X_JJ, tile columns from the right
+// LAUUM: (A^-1)_IJ = sum_{K >= I} X_KI^T * X_KJ, tile rows from the top
+void cholesky_inverse_tiled(lower_tiles_t *T)
+{
+    int nt = T->nt;
+    double **sum = allocate_matrix(TILE_SIZE);
+
+    for (int K = 0; K < nt; K++)
+    {
+        invert_lower_diagonal_tile(TILE(T, K, K), tile_dimension(T, K));
+    }
+    for (int J = nt - 1; J >= 0; J--)
+    {
+        for (int I = nt - 1; I > J; I--)
+        {
+            for (int i = 0; i < TILE_SIZE; i++)
+            {
+                memset(sum[i], 0, TILE_SIZE * sizeof(double));
+            }
+            for (int K = J + 1; K <= I; K++)
+            {
+                subtract_tile_product(sum, TILE(T, I, K), 0, TILE(T, K, J), 0, 0);
+            }
+            // sum holds -(sum_K X_IK * L_KJ), L_IJ has been read so X_IJ can take its place
+            strassen_mult(sum, TILE(T, J, J), TILE(T, I, J), TILE_SIZE);
+        }
+    }
+
+    for (int I = 0; I < nt; I++)
+    {
+        for (int J = 0; J <= I; J++)
+        {
+            for (int i = 0; i < TILE_SIZE; i++)
+            {
+                memset(sum[i], 0, TILE_SIZE * sizeof(double));
+            }
+            for (int K = I; K < nt; K++)
+            {
+                subtract_tile_product(sum, TILE(T, K, I), 1, TILE(T, K, J), 0, I == J);
+            }
+            for (int i = 0; i < TILE_SIZE; i++)
+            {
+                for (int j = 0; j < TILE_SIZE; j++)
+                {
+                    TILE(T, I, J)[i][j] = -sum[i][j];
+                }
+            }
+        }
+    }
+
+    free_matrix(sum, TILE_SIZE);
+}
+
+// Cholesky factor of an SPD matrix, only the lower triangle of A is read
+// Returns CALCULATION_ERROR with the failing column when A is not positive definite
+int cholesky_decomposition(double **A, double **L, int n, int *failed_column)
+{
+    if (A == NULL || L == NULL || n < 1)
+    {
+        return INCORRECT_MATRIX;
+    }
+    // A non-positive diagonal entry already rules out SPD, no flop is spent on it
+    for (int i = 0; i < n; i++)
+    {
+        if (!(A[i][i] > 0.0))
+        {
+            *failed_column = i;
+            return CALCULATION_ERROR;
+        }
+    }
+
+    lower_tiles_t T;
+    to_lower_tiles(A, n, &T);
+    int status = cholesky_tiled(&T, failed_column);
+    if (status == OK)
+    {
+        from_lower_tiles(&T, L, 0);
+    }
+    free_lower_tiles(&T);
+    return status;
+}
+
+// SPD inverse (POTRF + POTRI) at about half the flops and storage of the LU based inverse
+// When L is not NULL the Cholesky factor is copied out of the tiles before they are overwritten by the inverse,
+// so a caller that also needs L does not factorize A a second time
+int spd_inversion(double **A, double **A_inv, double **L, int n, int *failed_column)
+{
+    if (A == NULL || A_inv == NULL || n < 1)
+    {
+        return INCORRECT_MATRIX;
+    }
+    for (int i = 0; i < n; i++)
+    {
+        if (!(A[i][i] > 0.0))
+        {
+            *failed_column = i;
+            return CALCULATION_ERROR;
+        }
+    }
+
+    lower_tiles_t T;
+    to_lower_tiles(A, n, &T);
+    int status = cholesky_tiled(&T, failed_column);
+    if (status == OK)
+    {
+        if (L != NULL)
+        {
+            from_lower_tiles(&T, L, 0);
+        }
+        cholesky_inverse_tiled(&T);
+        from_lower_tiles(&T, A_inv, 1);
+    }
+    free_lower_tiles(&T);
+    return status;
+}
+
+// Function that request user to input Matrix elements
+void RequestInput(const char *name, double **matrix, int n)
+{
+    printf("Input Matrix %s Elements:\n", name);
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            printf("%s[%d][%d]=", name, i, j);
+            scanf("%lf", &matrix[i][j]);
+        }
+    }
+}
+
+int main()
+{
+    clock_t start_time, end_time;
+    int size, failed_column;
+
+    // Step 1: Get dimensions for Matrix A
+    printf("\nChoose Matrix Dimension for the square matrix: ");
+    scanf("%d", &size);
+
+    // Error condition 1
+    if (size <= 0)
+    {
+        printf("Matrix Size can only be larger than zero, the program will exit...");
+        exit(1);
+    }
+
+    // Step 2: Allocate matrices memory
+    double **A = allocate_matrix(size);
+    double **L = allocate_matrix(size);
+    double **A_inv = allocate_matrix(size);
+
+    // Note: You can either enter the matrix input manually, or choose to fill the matrices automatically. But make sure to comment "RequestInput" function calls, and to uncomment the alternative random input option.
+    // Step 3: Asking the user to input Matrix A elements
+    RequestInput("A", A, size);
+
+    // This is an alternative random input option (diagonally dominant, hence SPD), but make sure to comment "RequestInput" function calls.
+    /*for (int i = 0; i < size; i++)
+    {
+        for (int j = 0; j <= i; j++)
+        {
+            A[i][j] = (i == j) ? size : ((double)rand() / RAND_MAX);
+            A[j][i] = A[i][j];
+        }
+    }*/
+
+    // Error condition 2
+    for (int i = 0; i < size; i++)
+    {
+        for (int j = 0; j < i; j++)
+        {
+            if (A[i][j] != A[j][i])
+            {
+                printf("Matrix is not symmetric, the program will exit...");
+                exit(1);
+            }
+        }
+    }
+
+    // Step 4: Perform the SPD inversion, L is taken from its single Cholesky factorization
+    start_time = clock();
+    int status = spd_inversion(A, A_inv, L, size, &failed_column);
+    end_time = clock();
+
+    // Error condition 3
+    if (status != OK)
+    {
+        printf("Matrix is not positive definite (pivot %d is not positive), the program will exit...", failed_column);
+        exit(1);
+    }
+
+    // Step 5: Print results
+    printMatrix("Matrix A", A, size);
+    printMatrix("Cholesky factor L", L, size);
+    printMatrix("Matrix A inverse", A_inv, size);
+    printf("\nTime taken for the Cholesky factorization and SPD inversion: %.6f seconds\n", (double)(end_time - start_time) / CLOCKS_PER_SEC);
+
+    // Step 6: Free memory
+    free_matrix(A, size);
+    free_matrix(L, size);
+    free_matrix(A_inv, size);
+
+    return 0;
+}
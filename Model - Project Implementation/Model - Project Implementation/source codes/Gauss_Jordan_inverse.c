@@ -0,0 +1,279 @@
+/*
+Group 03
+
+Hani Abdallah - 21400302
+Houssam Eddine Jamil Nasser - 21400407
+Tan Viet Nguyen - 21400381
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// Width of the column panels, the updates outside a panel are matrix-matrix products of this inner size
+#define GJ_BLOCK_SIZE 64
+
+enum ERROR_CODES
+{
+    OK,
+    INCORRECT_MATRIX,
+    CALCULATION_ERROR
+};
+
+// allocate memory for matrices
+double **allocateMatrix(int rows, int columns)
+{
+    double **matrix = (double **)malloc(rows * sizeof(double *));
+    for (int i = 0; i < rows; i++)
+    {
+        matrix[i] = (double *)malloc(columns * sizeof(double));
+    }
+    return matrix;
+}
+
+// free allocated memory of matrices
+void freeMatrix(double **matrix, int rows)
+{
+    for (int i = 0; i < rows; i++)
+    {
+        free(matrix[i]);
+    }
+    free(matrix);
+}
+
+// Function to print a matrix
+void printMatrix(const char *name, double **matrix, int n)
+{
+    printf("%s:\n", name);
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            printf("%10.4f ", matrix[i][j]);
+        }
+        printf("\n");
+    }
+}
+
+// Unblocked in-place Gauss-Jordan on the panel of columns k .. k+b-1, all n rows
+// Pivots are searched on and below the diagonal, row swaps exchange whole row pointers
+// On return the panel holds [-A01 * A11^-1; A11^-1; -A21 * A11^-1] of the pivoted matrix
+int panelGaussJordan(double **A, int n, int k, int b, int *ipiv)
+{
+    for (int c = k; c < k + b; c++)
+    {
+        int pivot = c;
+        for (int i = c + 1; i < n; i++)
+        {
+            if (fabs(A[i][c]) > fabs(A[pivot][c]))
+            {
+                pivot = i;
+            }
+        }
+        ipiv[c] = pivot;
+        if (A[pivot][c] == 0.0)
+        {
+            return CALCULATION_ERROR;
+        }
+        if (pivot != c)
+        {
+            double *row = A[c];
+            A[c] = A[pivot];
+            A[pivot] = row;
+        }
+
+        // Scale the pivot row, the pivot position keeps the matching entry of the inverse
+        double pivot_value = A[c][c];
+        A[c][c] = 1.0;
+        for (int j = k; j < k + b; j++)
+        {
+            A[c][j] /= pivot_value;
+        }
+
+        // Eliminate column c from every other row
+        for (int i = 0; i < n; i++)
+        {
+            if (i == c)
+            {
+                continue;
+            }
+            double factor = A[i][c];
+            A[i][c] = 0.0;
+            for (int j = k; j < k + b; j++)
+            {
+                A[i][j] -= factor * A[c][j];
+            }
+        }
+    }
+    return OK;
+}
+
+// In-place blocked Gauss-Jordan inversion with partial pivoting: A is overwritten by A^-1
+// For every panel of b columns, with block row / column 1 being the panel:
+//   panel:  [A01; A11; A21] -> [-A01 * A11^-1; A11^-1; -A21 * A11^-1]
+//   update: Ai0 += Ai1 * A10 and Ai2 += Ai1 * A12 for the other block rows i, then A10 = A11 * A10, A12 = A11 * A12
+// Only one n x n buffer is used, plus a b x n work block and the pivot vector
+// The row interchanges are undone at the end as column interchanges in reverse order
+int gaussJordanInverse(double **A, int n)
+{
+    if (A == NULL || n < 1)
+    {
+        return INCORRECT_MATRIX;
+    }
+
+    int *ipiv = malloc(n * sizeof(int));
+    double **W = allocateMatrix(GJ_BLOCK_SIZE, n);
+    int status = OK;
+
+    for (int k = 0; k < n && status == OK; k += GJ_BLOCK_SIZE)
+    {
+        int b = (n - k < GJ_BLOCK_SIZE) ? n - k : GJ_BLOCK_SIZE;
+
+        // Step 1: Gauss-Jordan on the panel
+        status = panelGaussJordan(A, n, k, b, ipiv);
+        if (status != OK)
+        {
+            break;
+        }
+
+        // Step 2: the other block rows, Ai0 += Ai1 * A10 and Ai2 += Ai1 * A12
+        for (int i = 0; i < n; i++)
+        {
+            if (i >= k && i < k + b)
+            {
+                continue;
+            }
+            for (int p = k; p < k + b; p++)
+            {
+                double factor = A[i][p];
+                double *pivot_row = A[p];
+                for (int j = 0; j < k; j++)
+                {
+                    A[i][j] += factor * pivot_row[j];
+                }
+                for (int j = k + b; j < n; j++)
+                {
+                    A[i][j] += factor * pivot_row[j];
+                }
+            }
+        }
+
+        // Step 3: the panel rows, A10 = A11 * A10 and A12 = A11 * A12 through the work block
+        for (int r = 0; r < b; r++)
+        {
+            memset(W[r], 0, n * sizeof(double));
+            for (int p = 0; p < b; p++)
+            {
+                double factor = A[k + r][k + p];
+                double *pivot_row = A[k + p];
+                for (int j = 0; j < k; j++)
+                {
+                    W[r][j] += factor * pivot_row[j];
+                }
+                for (int j = k + b; j < n; j++)
+                {
+                    W[r][j] += factor * pivot_row[j];
+                }
+            }
+        }
+        for (int r = 0; r < b; r++)
+        {
+            memcpy(A[k + r], W[r], k * sizeof(double));
+            memcpy(&A[k + r][k + b], &W[r][k + b], (n - k - b) * sizeof(double));
+        }
+    }
+
+    // Undo the row interchanges: swap the matching columns, last interchange first
+    if (status == OK)
+    {
+        for (int c = n - 1; c >= 0; c--)
+        {
+            if (ipiv[c] != c)
+            {
+                for (int i = 0; i < n; i++)
+                {
+                    double temp = A[i][c];
+                    A[i][c] = A[i][ipiv[c]];
+                    A[i][ipiv[c]] = temp;
+                }
+            }
+        }
+    }
+
+    freeMatrix(W, GJ_BLOCK_SIZE);
+    free(ipiv);
+    return status;
+}
+
+// Function that request user to input Matrix elements
+void RequestInput(const char *name, double **matrix, int n)
+{
+    printf("Input Matrix %s Elements:\n", name);
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            printf("%s[%d][%d]=", name, i, j);
+            scanf("%lf", &matrix[i][j]);
+        }
+    }
+}
+
+int main()
+{
+    clock_t start_time, end_time;
+    int n;
+
+    // Step 1: Get dimensions for Matrix A
+    printf("\nChoose Matrix Dimension for the square matrix: ");
+    scanf("%d", &n);
+
+    // Error condition 1
+    if (n <= 0)
+    {
+        printf("Matrix Size can only be larger than zero, the program will exit...");
+        exit(1);
+    }
+
+    // Step 2: Allocate matrix memory, the inverse overwrites A
+    double **A = allocateMatrix(n, n);
+
+    // Note: You can either enter the matrix input manually, or choose to fill the matrices automatically. But make sure to comment "RequestInput" function calls, and to uncomment the alternative random input option.
+    // Step 3: Asking the user to input Matrix A elements
+    RequestInput("A", A, n);
+
+    // This is an alternative random input option, but make sure to comment "RequestInput" function calls.
+    /*for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            A[i][j] = (double)rand() / RAND_MAX;
+        }
+    }*/
+
+    printMatrix("Matrix A", A, n);
+
+    // Step 4: Invert A in place
+    start_time = clock();
+    int status = gaussJordanInverse(A, n);
+    end_time = clock();
+
+    // Error condition 2
+    if (status != OK)
+    {
+        printf("Matrix is singular, the program will exit...");
+        exit(1);
+    }
+
+    // Step 5: Print results
+    printMatrix("Matrix A inverse", A, n);
+    printf("\nTime taken for the in-place Gauss-Jordan inversion: %.6f seconds\n", (double)(end_time - start_time) / CLOCKS_PER_SEC);
+
+    // Step 6: Free memory
+    freeMatrix(A, n);
+
+    return 0;
+}
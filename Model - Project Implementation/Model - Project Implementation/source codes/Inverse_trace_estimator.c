@@ -0,0 +1,567 @@
+/*
+Group 03
+
+Hani Abdallah - 21400302
+Houssam Eddine Jamil Nasser - 21400407
+Tan Viet Nguyen - 21400381
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// Probe vectors are solved PROBE_BATCH at a time as one multi right-hand side block, bounding the memory to n x PROBE_BATCH
+#define PROBE_BATCH 32
+
+enum ERROR_CODES
+{
+    OK,
+    INCORRECT_MATRIX,
+    CALCULATION_ERROR
+};
+
+enum FACTORIZATION_TYPES
+{
+    LU_FACTORS,
+    CHOLESKY_FACTORS
+};
+
+enum ESTIMATOR_TYPES
+{
+    HUTCHINSON,
+    HUTCH_PLUS_PLUS
+};
+
+// Factor-and-solve handle behind the estimators
+// LU_FACTORS: P * A = L * U, L (unit diagonal, not stored) and U share factors, perm[i] is the row of A in row i
+// CHOLESKY_FACTORS: A = L * L^T for symmetric positive definite A, L in the lower triangle of factors, perm is NULL
+typedef struct inverse_solver_struct
+{
+    double **factors;
+    int *perm;
+    int n;
+    int type;
+} inverse_solver_t;
+
+// Function to allocate memory for a matrix
+double **allocateMatrix(int rows, int columns)
+{
+    double **matrix = malloc(rows * sizeof(double *));
+    for (int i = 0; i < rows; i++)
+    {
+        matrix[i] = malloc(columns * sizeof(double));
+    }
+    return matrix;
+}
+
+// Free allocated matrix memory
+void freeMatrix(double **matrix, int rows)
+{
+    for (int i = 0; i < rows; i++)
+    {
+        free(matrix[i]);
+    }
+    free(matrix);
+}
+
+// Copy Matrix A to Matrix B
+void copyMatrix(double **original_matrix, double **copied_matrix, int rows, int columns)
+{
+    for (int i = 0; i < rows; i++)
+    {
+        memcpy(copied_matrix[i], original_matrix[i], columns * sizeof(double));
+    }
+}
+
+// Function to print a matrix
+void printMatrix(const char *name, double **matrix, int rows, int columns)
+{
+    printf("%s:\n", name);
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < columns; j++)
+        {
+            printf("%10.4f ", matrix[i][j]);
+        }
+        printf("\n");
+    }
+}
+
+void freeSolver(inverse_solver_t *solver)
+{
+    if (solver != NULL && solver->factors != NULL)
+    {
+        freeMatrix(solver->factors, solver->n);
+        free(solver->perm);
+        solver->factors = NULL;
+        solver->perm = NULL;
+    }
+}
+
+// Factorize A once for all probe solves, A is left untouched
+// CALCULATION_ERROR: A is singular (LU) or not positive definite (Cholesky), nothing is kept allocated
+int factorizeSolver(double **A, int n, int type, inverse_solver_t *solver)
+{
+    if (A == NULL || solver == NULL || n < 1 || (type != LU_FACTORS && type != CHOLESKY_FACTORS))
+    {
+        return INCORRECT_MATRIX;
+    }
+
+    double **F = allocateMatrix(n, n);
+    copyMatrix(A, F, n, n);
+    solver->factors = F;
+    solver->perm = NULL;
+    solver->n = n;
+    solver->type = type;
+    int status = OK;
+
+    if (type == CHOLESKY_FACTORS)
+    {
+        for (int k = 0; k < n && status == OK; k++)
+        {
+            double pivot = F[k][k];
+            for (int p = 0; p < k; p++)
+            {
+                pivot -= F[k][p] * F[k][p];
+            }
+            if (pivot <= 0.0)
+            {
+                status = CALCULATION_ERROR;
+                break;
+            }
+            F[k][k] = sqrt(pivot);
+            for (int i = k + 1; i < n; i++)
+            {
+                double sum = F[i][k];
+                for (int p = 0; p < k; p++)
+                {
+                    sum -= F[i][p] * F[k][p];
+                }
+                F[i][k] = sum / F[k][k];
+            }
+        }
+    }
+    else
+    {
+        int *perm = malloc(n * sizeof(int));
+        solver->perm = perm;
+        for (int i = 0; i < n; i++)
+        {
+            perm[i] = i;
+        }
+        for (int k = 0; k < n && status == OK; k++)
+        {
+            // Pivot: largest entry of column k on or below the diagonal
+            int pivot = k;
+            for (int i = k + 1; i < n; i++)
+            {
+                if (fabs(F[i][k]) > fabs(F[pivot][k]))
+                {
+                    pivot = i;
+                }
+            }
+            if (F[pivot][k] == 0.0)
+            {
+                status = CALCULATION_ERROR;
+                break;
+            }
+            if (pivot != k)
+            {
+                double *row = F[k];
+                F[k] = F[pivot];
+                F[pivot] = row;
+                int index = perm[k];
+                perm[k] = perm[pivot];
+                perm[pivot] = index;
+            }
+            for (int i = k + 1; i < n; i++)
+            {
+                double factor = F[i][k] / F[k][k];
+                F[i][k] = factor;
+                for (int j = k + 1; j < n; j++)
+                {
+                    F[i][j] -= factor * F[k][j];
+                }
+            }
+        }
+    }
+
+    if (status != OK)
+    {
+        freeSolver(solver);
+    }
+    return status;
+}
+
+// X = A^-1 * B for an n x m block of right-hand sides
+// Every row of the factors is applied to all m columns before moving on, so each factor row is read once per block
+void solveBlock(inverse_solver_t *solver, double **B, double **X, int m)
+{
+    int n = solver->n;
+    double **F = solver->factors;
+
+    for (int i = 0; i < n; i++)
+    {
+        memcpy(X[i], B[(solver->perm != NULL) ? solver->perm[i] : i], m * sizeof(double));
+    }
+
+    // Forward substitution: L Y = P B (unit diagonal for LU)
+    for (int i = 0; i < n; i++)
+    {
+        for (int k = 0; k < i; k++)
+        {
+            double factor = F[i][k];
+            for (int j = 0; j < m; j++)
+            {
+                X[i][j] -= factor * X[k][j];
+            }
+        }
+        if (solver->type == CHOLESKY_FACTORS)
+        {
+            for (int j = 0; j < m; j++)
+            {
+                X[i][j] /= F[i][i];
+            }
+        }
+    }
+
+    // Backward substitution: U X = Y, or L^T X = Y where row i of L^T is column i of L
+    for (int i = n - 1; i >= 0; i--)
+    {
+        for (int k = i + 1; k < n; k++)
+        {
+            double factor = (solver->type == CHOLESKY_FACTORS) ? F[k][i] : F[i][k];
+            for (int j = 0; j < m; j++)
+            {
+                X[i][j] -= factor * X[k][j];
+            }
+        }
+        for (int j = 0; j < m; j++)
+        {
+            X[i][j] /= F[i][i];
+        }
+    }
+}
+
+// Fill the n x m block Z with independent Rademacher entries (+1 or -1 with equal probability)
+void rademacherBlock(double **Z, int n, int m)
+{
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < m; j++)
+        {
+            Z[i][j] = (rand() & 1) ? 1.0 : -1.0;
+        }
+    }
+}
+
+// Hutchinson: trace(A^-1) ~ 1/s * sum_k z_k^T A^-1 z_k over s Rademacher probes z_k
+// With the same probes diag(A^-1) ~ 1/s * sum_k z_k .* (A^-1 z_k), pass NULL when the diagonal is not needed
+// The error falls like 1/sqrt(samples)
+double hutchinsonEstimate(inverse_solver_t *solver, int samples, double *diagonal)
+{
+    int n = solver->n;
+    double **Z = allocateMatrix(n, PROBE_BATCH);
+    double **X = allocateMatrix(n, PROBE_BATCH);
+    double trace = 0.0;
+
+    if (diagonal != NULL)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            diagonal[i] = 0.0;
+        }
+    }
+
+    for (int done = 0; done < samples; done += PROBE_BATCH)
+    {
+        int m = (samples - done < PROBE_BATCH) ? samples - done : PROBE_BATCH;
+        rademacherBlock(Z, n, m);
+        solveBlock(solver, Z, X, m);
+        for (int i = 0; i < n; i++)
+        {
+            double sum = 0.0;
+            for (int j = 0; j < m; j++)
+            {
+                sum += Z[i][j] * X[i][j];
+            }
+            trace += sum;
+            if (diagonal != NULL)
+            {
+                diagonal[i] += sum;
+            }
+        }
+    }
+
+    if (diagonal != NULL)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            diagonal[i] /= samples;
+        }
+    }
+
+    freeMatrix(Z, n);
+    freeMatrix(X, n);
+    return trace / samples;
+}
+
+// Orthonormalize the columns of the n x k block Q in place, modified Gram-Schmidt run twice for stability
+// Returns the number of independent columns, which are moved to the front
+int orthonormalizeColumns(double **Q, int n, int k)
+{
+    int rank = 0;
+    for (int j = 0; j < k; j++)
+    {
+        double original_norm = 0.0;
+        for (int i = 0; i < n; i++)
+        {
+            original_norm += Q[i][j] * Q[i][j];
+        }
+        original_norm = sqrt(original_norm);
+
+        for (int pass = 0; pass < 2; pass++)
+        {
+            for (int p = 0; p < rank; p++)
+            {
+                double dot = 0.0;
+                for (int i = 0; i < n; i++)
+                {
+                    dot += Q[i][p] * Q[i][j];
+                }
+                for (int i = 0; i < n; i++)
+                {
+                    Q[i][j] -= dot * Q[i][p];
+                }
+            }
+        }
+
+        double norm = 0.0;
+        for (int i = 0; i < n; i++)
+        {
+            norm += Q[i][j] * Q[i][j];
+        }
+        norm = sqrt(norm);
+
+        // A column that vanished against the previous ones adds nothing to the range
+        if (norm <= 1e-12 * original_norm || norm == 0.0)
+        {
+            continue;
+        }
+        for (int i = 0; i < n; i++)
+        {
+            Q[i][rank] = Q[i][j] / norm;
+        }
+        rank++;
+    }
+    return rank;
+}
+
+// Hutch++: the samples (solves with A) are split in three, k = samples / 3 each for
+//   Q = orth(A^-1 S), the dominant range of A^-1,
+//   the exact part trace(Q^T A^-1 Q) (at most k solves, one per column kept in Q),
+// and the remaining samples - 2k for Hutchinson on the deflated remainder (I - Q Q^T) A^-1 (I - Q Q^T)
+// so the total never exceeds samples; the error falls like 1/samples instead of 1/sqrt(samples) when A^-1 has a
+// few dominant eigenvalues
+double hutchPlusPlusEstimate(inverse_solver_t *solver, int samples)
+{
+    int n = solver->n;
+    int k = samples / 3;
+    if (k < 1)
+    {
+        return hutchinsonEstimate(solver, samples, NULL);
+    }
+    if (k > n)
+    {
+        k = n;
+    }
+    int remaining = samples - 2 * k;
+
+    // Step 1: Q = orth(A^-1 S)
+    double **S = allocateMatrix(n, k);
+    double **Q = allocateMatrix(n, k);
+    rademacherBlock(S, n, k);
+    solveBlock(solver, S, Q, k);
+    int rank = orthonormalizeColumns(Q, n, k);
+
+    // Step 2: exact part trace(Q^T A^-1 Q)
+    double trace = 0.0;
+    if (rank > 0)
+    {
+        double **QQ = allocateMatrix(n, rank);
+        double **X = allocateMatrix(n, rank);
+        for (int i = 0; i < n; i++)
+        {
+            memcpy(QQ[i], Q[i], rank * sizeof(double));
+        }
+        solveBlock(solver, QQ, X, rank);
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < rank; j++)
+            {
+                trace += QQ[i][j] * X[i][j];
+            }
+        }
+        freeMatrix(QQ, n);
+        freeMatrix(X, n);
+    }
+
+    // Step 3: Hutchinson on the deflated operator, probes g - Q Q^T g in batches
+    double **G = allocateMatrix(n, PROBE_BATCH);
+    double **X = allocateMatrix(n, PROBE_BATCH);
+    double *coefficients = malloc(PROBE_BATCH * sizeof(double));
+    double remainder = 0.0;
+    for (int done = 0; done < remaining; done += PROBE_BATCH)
+    {
+        int m = (remaining - done < PROBE_BATCH) ? remaining - done : PROBE_BATCH;
+        rademacherBlock(G, n, m);
+        for (int p = 0; p < rank; p++)
+        {
+            for (int j = 0; j < m; j++)
+            {
+                coefficients[j] = 0.0;
+            }
+            for (int i = 0; i < n; i++)
+            {
+                for (int j = 0; j < m; j++)
+                {
+                    coefficients[j] += Q[i][p] * G[i][j];
+                }
+            }
+            for (int i = 0; i < n; i++)
+            {
+                for (int j = 0; j < m; j++)
+                {
+                    G[i][j] -= coefficients[j] * Q[i][p];
+                }
+            }
+        }
+        solveBlock(solver, G, X, m);
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < m; j++)
+            {
+                remainder += G[i][j] * X[i][j];
+            }
+        }
+    }
+
+    freeMatrix(S, n);
+    freeMatrix(Q, n);
+    freeMatrix(G, n);
+    freeMatrix(X, n);
+    free(coefficients);
+    return trace + remainder / remaining;
+}
+
+// Function that request user to input Matrix elements
+void RequestInput(const char *name, double **matrix, int rows, int columns)
+{
+    printf("Input Matrix %s Elements:\n", name);
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < columns; j++)
+        {
+            printf("%s[%d][%d]=", name, i, j);
+            scanf("%lf", &matrix[i][j]);
+        }
+    }
+}
+
+int main()
+{
+    clock_t start_time, end_time;
+    int n, estimator, type, samples;
+
+    // Step 1: Get dimensions for Matrix A, the estimator, the factorization and the sample count
+    printf("\nChoose Matrix Dimension for the square matrix: ");
+    scanf("%d", &n);
+    printf("\nChoose the estimator (0: Hutchinson with diagonal, 1: Hutch++): ");
+    scanf("%d", &estimator);
+    printf("\nChoose the factorization (0: LU, 1: Cholesky for symmetric positive definite A): ");
+    scanf("%d", &type);
+    printf("\nChoose the number of probe vectors: ");
+    scanf("%d", &samples);
+
+    // Error condition 1
+    if (n <= 0 || samples <= 0)
+    {
+        printf("Matrix Size and sample count can only be larger than zero, the program will exit...");
+        exit(1);
+    }
+
+    // Error condition 2
+    if ((estimator != HUTCHINSON && estimator != HUTCH_PLUS_PLUS) || (type != LU_FACTORS && type != CHOLESKY_FACTORS))
+    {
+        printf("Estimator and factorization can only be 0 or 1, the program will exit...");
+        exit(1);
+    }
+
+    // Step 2: Allocate matrix memory
+    double **A = allocateMatrix(n, n);
+
+    // Note: You can either enter the matrix input manually, or choose to fill the matrices automatically. But make sure to comment "RequestInput" function calls, and to uncomment the alternative random input option.
+    // Step 3: Asking the user to input Matrix A elements
+    RequestInput("A", A, n, n);
+
+    // This is an alternative random input option, but make sure to comment "RequestInput" function calls.
+    /*for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j <= i; j++)
+        {
+            A[i][j] = A[j][i] = (i == j) ? n : ((double)rand() / RAND_MAX);
+        }
+    }*/
+
+    // Step 4: Factorize A once
+    inverse_solver_t solver;
+    start_time = clock();
+    int status = factorizeSolver(A, n, type, &solver);
+    end_time = clock();
+
+    // Error condition 3
+    if (status != OK)
+    {
+        printf("Matrix is singular or not positive definite, the program will exit...");
+        exit(1);
+    }
+    printf("Time taken for the factorization: %.6f seconds\n", (double)(end_time - start_time) / CLOCKS_PER_SEC);
+
+    // Step 5: Estimate trace(A^-1), and diag(A^-1) with Hutchinson
+    double *diagonal = NULL;
+    double trace;
+    start_time = clock();
+    if (estimator == HUTCHINSON)
+    {
+        diagonal = malloc(n * sizeof(double));
+        trace = hutchinsonEstimate(&solver, samples, diagonal);
+    }
+    else
+    {
+        trace = hutchPlusPlusEstimate(&solver, samples);
+    }
+    end_time = clock();
+
+    // Step 6: Print results
+    printf("Estimated trace of A inverse: %.6f (%d probe vectors)\n", trace, samples);
+    if (diagonal != NULL)
+    {
+        printf("Estimated diagonal of A inverse:\n");
+        for (int i = 0; i < n; i++)
+        {
+            printf("%10.4f ", diagonal[i]);
+        }
+        printf("\n");
+    }
+    printf("Time taken for the estimation: %.6f seconds\n", (double)(end_time - start_time) / CLOCKS_PER_SEC);
+
+    // Step 7: Free memory
+    freeSolver(&solver);
+    freeMatrix(A, n);
+    free(diagonal);
+
+    return 0;
+}
@@ -0,0 +1,509 @@
+/*
+Group 03
+
+Hani Abdallah - 21400302
+Houssam Eddine Jamil Nasser - 21400407
+Tan Viet Nguyen - 21400381
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// Bunch-Kaufman threshold (1 + sqrt(17)) / 8, bounds the element growth of 1x1 and 2x2 pivots alike
+#define BUNCH_KAUFMAN_ALPHA 0.6403882032022076
+
+enum ERROR_CODES
+{
+    OK,
+    INCORRECT_MATRIX,
+    CALCULATION_ERROR
+};
+
+// Persistent factorization handle: P * A * P^T = L * D * L^T, D block diagonal with 1x1 and 2x2 blocks
+// LD is the lower triangle only (row i holds i + 1 entries): L below the diagonal, D on the diagonal
+// and, for a 2x2 block starting at k, its off-diagonal entry in LD[k + 1][k]
+// ipiv[k] >= 0: 1x1 block, rows k and ipiv[k] were interchanged
+// ipiv[k] = ipiv[k + 1] = -(p + 1) < 0: 2x2 block, rows k + 1 and p were interchanged
+typedef struct ldlt_factorization_struct
+{
+    double **LD;
+    int *ipiv;
+    int n;
+} ldlt_factorization_t;
+
+// Function to allocate memory for a matrix
+double **allocateMatrix(int rows, int columns)
+{
+    double **matrix = malloc(rows * sizeof(double *));
+    for (int i = 0; i < rows; i++)
+    {
+        matrix[i] = malloc(columns * sizeof(double));
+    }
+    return matrix;
+}
+
+// Free allocated matrix memory
+void freeMatrix(double **matrix, int rows)
+{
+    for (int i = 0; i < rows; i++)
+    {
+        free(matrix[i]);
+    }
+    free(matrix);
+}
+
+// Function to print a matrix
+void printMatrix(const char *name, double **matrix, int rows, int columns)
+{
+    printf("%s:\n", name);
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < columns; j++)
+        {
+            printf("%10.4f ", matrix[i][j]);
+        }
+        printf("\n");
+    }
+}
+
+// Symmetric interchange of rows and columns kk < kp inside the trailing lower triangle starting at column k
+void symmetricInterchange(double **LD, int n, int k, int kk, int kp)
+{
+    double temp;
+    for (int i = kp + 1; i < n; i++)
+    {
+        temp = LD[i][kk];
+        LD[i][kk] = LD[i][kp];
+        LD[i][kp] = temp;
+    }
+    for (int j = kk + 1; j < kp; j++)
+    {
+        temp = LD[j][kk];
+        LD[j][kk] = LD[kp][j];
+        LD[kp][j] = temp;
+    }
+    temp = LD[kk][kk];
+    LD[kk][kk] = LD[kp][kp];
+    LD[kp][kp] = temp;
+    if (kk != k)
+    {
+        temp = LD[kk][k];
+        LD[kk][k] = LD[kp][k];
+        LD[kp][k] = temp;
+    }
+}
+
+// LDL^T factorization with Bunch-Kaufman pivoting, only the lower triangle of A is read
+// Every step picks a 1x1 pivot, a 1x1 pivot after an interchange, or a 2x2 pivot, whichever keeps growth bounded;
+// the trailing update touches the lower triangle only, half the flops and memory of LU
+int LDLT_Factorize(double **A, int n, ldlt_factorization_t *factorization)
+{
+    if (A == NULL || factorization == NULL || n < 1)
+    {
+        return INCORRECT_MATRIX;
+    }
+
+    double **LD = malloc(n * sizeof(double *));
+    int *ipiv = malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++)
+    {
+        LD[i] = malloc((i + 1) * sizeof(double));
+        memcpy(LD[i], A[i], (i + 1) * sizeof(double));
+    }
+    factorization->LD = LD;
+    factorization->ipiv = ipiv;
+    factorization->n = n;
+
+    int k = 0;
+    while (k < n)
+    {
+        int kstep = 1;
+        int kp = k;
+        double absakk = fabs(LD[k][k]);
+
+        // Largest entry below the diagonal in column k
+        int imax = k;
+        double colmax = 0.0;
+        for (int i = k + 1; i < n; i++)
+        {
+            if (fabs(LD[i][k]) > colmax)
+            {
+                colmax = fabs(LD[i][k]);
+                imax = i;
+            }
+        }
+
+        // A zero column in the trailing matrix: A is singular
+        if (absakk == 0.0 && colmax == 0.0)
+        {
+            freeMatrix(LD, n);
+            free(ipiv);
+            factorization->LD = NULL;
+            factorization->ipiv = NULL;
+            return CALCULATION_ERROR;
+        }
+        if (absakk < BUNCH_KAUFMAN_ALPHA * colmax)
+        {
+            // Largest off-diagonal entry in row / column imax
+            double rowmax = 0.0;
+            for (int j = k; j < imax; j++)
+            {
+                if (fabs(LD[imax][j]) > rowmax)
+                {
+                    rowmax = fabs(LD[imax][j]);
+                }
+            }
+            for (int i = imax + 1; i < n; i++)
+            {
+                if (fabs(LD[i][imax]) > rowmax)
+                {
+                    rowmax = fabs(LD[i][imax]);
+                }
+            }
+
+            if (absakk * rowmax >= BUNCH_KAUFMAN_ALPHA * colmax * colmax)
+            {
+                kp = k;
+            }
+            else if (fabs(LD[imax][imax]) >= BUNCH_KAUFMAN_ALPHA * rowmax)
+            {
+                kp = imax;
+            }
+            else
+            {
+                kp = imax;
+                kstep = 2;
+            }
+        }
+
+        int kk = k + kstep - 1;
+        if (kp != kk)
+        {
+            symmetricInterchange(LD, n, k, kk, kp);
+        }
+
+        if (kstep == 1)
+        {
+            // A22 -= l * d * l^T with l = A21 / d
+            double d = LD[k][k];
+            for (int j = k + 1; j < n; j++)
+            {
+                double factor = LD[j][k] / d;
+                for (int i = j; i < n; i++)
+                {
+                    LD[i][j] -= LD[i][k] * factor;
+                }
+            }
+            for (int i = k + 1; i < n; i++)
+            {
+                LD[i][k] /= d;
+            }
+            ipiv[k] = kp;
+        }
+        else
+        {
+            // 2x2 block D = [d11 d21; d21 d22], rows of L are [a_ik a_ik+1] * D^-1
+            double d11 = LD[k][k];
+            double d21 = LD[k + 1][k];
+            double d22 = LD[k + 1][k + 1];
+            double det = d11 * d22 - d21 * d21;
+            for (int j = k + 2; j < n; j++)
+            {
+                double wk = (d22 * LD[j][k] - d21 * LD[j][k + 1]) / det;
+                double wkp1 = (d11 * LD[j][k + 1] - d21 * LD[j][k]) / det;
+                for (int i = j; i < n; i++)
+                {
+                    LD[i][j] -= LD[i][k] * wk + LD[i][k + 1] * wkp1;
+                }
+                LD[j][k] = wk;
+                LD[j][k + 1] = wkp1;
+            }
+            ipiv[k] = -(kp + 1);
+            ipiv[k + 1] = -(kp + 1);
+        }
+        k += kstep;
+    }
+    return OK;
+}
+
+void LDLT_FreeFactorization(ldlt_factorization_t *factorization)
+{
+    if (factorization != NULL && factorization->LD != NULL)
+    {
+        freeMatrix(factorization->LD, factorization->n);
+        free(factorization->ipiv);
+        factorization->LD = NULL;
+        factorization->ipiv = NULL;
+    }
+}
+
+// Solve A x = b with the factors, the interchanges are replayed in the order they were made
+void LDLT_Solve(ldlt_factorization_t *factorization, double *b, double *x)
+{
+    int n = factorization->n;
+    double **LD = factorization->LD;
+    int *ipiv = factorization->ipiv;
+    double temp;
+    memcpy(x, b, n * sizeof(double));
+
+    // L * D y = P b
+    int k = 0;
+    while (k < n)
+    {
+        if (ipiv[k] >= 0)
+        {
+            int kp = ipiv[k];
+            temp = x[k];
+            x[k] = x[kp];
+            x[kp] = temp;
+            for (int i = k + 1; i < n; i++)
+            {
+                x[i] -= LD[i][k] * x[k];
+            }
+            x[k] /= LD[k][k];
+            k++;
+        }
+        else
+        {
+            int kp = -ipiv[k] - 1;
+            temp = x[k + 1];
+            x[k + 1] = x[kp];
+            x[kp] = temp;
+            for (int i = k + 2; i < n; i++)
+            {
+                x[i] -= LD[i][k] * x[k] + LD[i][k + 1] * x[k + 1];
+            }
+            double d11 = LD[k][k];
+            double d21 = LD[k + 1][k];
+            double d22 = LD[k + 1][k + 1];
+            double det = d11 * d22 - d21 * d21;
+            double xk = (d22 * x[k] - d21 * x[k + 1]) / det;
+            double xkp1 = (d11 * x[k + 1] - d21 * x[k]) / det;
+            x[k] = xk;
+            x[k + 1] = xkp1;
+            k += 2;
+        }
+    }
+
+    // L^T P x = y, from the last block back to the first
+    k = n - 1;
+    while (k >= 0)
+    {
+        double sum = 0.0;
+        for (int i = k + 1; i < n; i++)
+        {
+            sum += LD[i][k] * x[i];
+        }
+        x[k] -= sum;
+        if (ipiv[k] >= 0)
+        {
+            int kp = ipiv[k];
+            temp = x[k];
+            x[k] = x[kp];
+            x[kp] = temp;
+            k--;
+        }
+        else
+        {
+            sum = 0.0;
+            for (int i = k + 1; i < n; i++)
+            {
+                sum += LD[i][k - 1] * x[i];
+            }
+            x[k - 1] -= sum;
+            int kp = -ipiv[k] - 1;
+            temp = x[k];
+            x[k] = x[kp];
+            x[kp] = temp;
+            k -= 2;
+        }
+    }
+}
+
+// Inverse of A from the factors, one solve per column of the identity
+// Only the lower part of every column is kept, the upper triangle is mirrored from it
+int LDLT_Inverse(ldlt_factorization_t *factorization, double **A_inverse)
+{
+    int n = factorization->n;
+    double *e = calloc(n, sizeof(double));
+    double *x = malloc(n * sizeof(double));
+    for (int j = 0; j < n; j++)
+    {
+        e[j] = 1.0;
+        LDLT_Solve(factorization, e, x);
+        e[j] = 0.0;
+        for (int i = j; i < n; i++)
+        {
+            A_inverse[i][j] = x[i];
+            A_inverse[j][i] = x[i];
+        }
+    }
+    free(e);
+    free(x);
+    return OK;
+}
+
+// Inertia of A (numbers of positive, negative and zero eigenvalues) read off D by Sylvester's law
+// A 2x2 block with negative determinant holds one positive and one negative eigenvalue
+void LDLT_Inertia(ldlt_factorization_t *factorization, int *positive, int *negative, int *zero)
+{
+    double **LD = factorization->LD;
+    *positive = 0;
+    *negative = 0;
+    *zero = 0;
+    int k = 0;
+    while (k < factorization->n)
+    {
+        if (factorization->ipiv[k] >= 0)
+        {
+            if (LD[k][k] > 0.0)
+            {
+                (*positive)++;
+            }
+            else if (LD[k][k] < 0.0)
+            {
+                (*negative)++;
+            }
+            else
+            {
+                (*zero)++;
+            }
+            k++;
+        }
+        else
+        {
+            double det = LD[k][k] * LD[k + 1][k + 1] - LD[k + 1][k] * LD[k + 1][k];
+            if (det < 0.0)
+            {
+                (*positive)++;
+                (*negative)++;
+            }
+            else if (LD[k][k] + LD[k + 1][k + 1] > 0.0)
+            {
+                *positive += 2;
+            }
+            else
+            {
+                *negative += 2;
+            }
+            k += 2;
+        }
+    }
+}
+
+// Function that request user to input Matrix elements
+void RequestInput(const char *name, double **matrix, int rows, int columns)
+{
+    printf("Input Matrix %s Elements:\n", name);
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < columns; j++)
+        {
+            printf("%s[%d][%d]=", name, i, j);
+            scanf("%lf", &matrix[i][j]);
+        }
+    }
+}
+
+int main()
+{
+    clock_t start_time, end_time;
+    int n;
+
+    // Step 1: Get dimensions for Matrix A
+    printf("\nChoose Matrix Dimension for the square matrix: ");
+    scanf("%d", &n);
+
+    // Error condition 1
+    if (n <= 0)
+    {
+        printf("Matrix Size can only be larger than zero, the program will exit...");
+        exit(1);
+    }
+
+    // Step 2: Allocate matrices memory
+    double **A = allocateMatrix(n, n);
+    double **B = allocateMatrix(n, 1);
+    double **X = allocateMatrix(n, 1);
+    double **A_inverse = allocateMatrix(n, n);
+
+    // Note: You can either enter the matrix input manually, or choose to fill the matrices automatically. But make sure to comment "RequestInput" function calls, and to uncomment the alternative random input option.
+    // Step 3: Asking the user to input Matrix A and the right-hand side b
+    RequestInput("A", A, n, n);
+    RequestInput("b", B, n, 1);
+
+    // This is an alternative random input option (symmetric, indefinite), but make sure to comment "RequestInput" function calls.
+    /*for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j <= i; j++)
+        {
+            A[i][j] = (double)rand() / RAND_MAX - 0.5;
+            A[j][i] = A[i][j];
+        }
+        B[i][0] = (double)rand() / RAND_MAX;
+    }*/
+
+    // Error condition 2
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < i; j++)
+        {
+            if (A[i][j] != A[j][i])
+            {
+                printf("Matrix is not symmetric, the program will exit...");
+                exit(1);
+            }
+        }
+    }
+
+    // Step 4: Factorize, solve and invert
+    ldlt_factorization_t factorization;
+    double *b = malloc(n * sizeof(double));
+    double *x = malloc(n * sizeof(double));
+    for (int i = 0; i < n; i++)
+    {
+        b[i] = B[i][0];
+    }
+
+    start_time = clock();
+    int status = LDLT_Factorize(A, n, &factorization);
+    end_time = clock();
+
+    // Error condition 3
+    if (status != OK)
+    {
+        printf("Matrix is singular, the program will exit...");
+        exit(1);
+    }
+    printf("Time taken for LDL^T Factorization: %.6f seconds\n", (double)(end_time - start_time) / CLOCKS_PER_SEC);
+
+    LDLT_Solve(&factorization, b, x);
+    LDLT_Inverse(&factorization, A_inverse);
+    for (int i = 0; i < n; i++)
+    {
+        X[i][0] = x[i];
+    }
+
+    // Step 5: Print results
+    int positive, negative, zero;
+    LDLT_Inertia(&factorization, &positive, &negative, &zero);
+    printMatrix("Matrix A", A, n, n);
+    printMatrix("Solution x", X, n, 1);
+    printMatrix("Matrix A inverse", A_inverse, n, n);
+    printf("Inertia: %d positive, %d negative, %d zero eigenvalues\n", positive, negative, zero);
+
+    // Step 6: Free memory
+    LDLT_FreeFactorization(&factorization);
+    freeMatrix(A, n);
+    freeMatrix(B, n);
+    freeMatrix(X, n);
+    freeMatrix(A_inverse, n);
+    free(b);
+    free(x);
+
+    return 0;
+}
@@ -9,7 +9,18 @@ Tan Viet Nguyen - 21400381
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <math.h>
+#include <float.h>
 #include <time.h>
+
+#define SUCCESS 1
+#define FAILURE 0
+
+// Inversion is refused above this estimated condition number, no digit of A^-1 could be trusted
+#define MAX_CONDITION_NUMBER (1.0 / DBL_EPSILON)
+// Hager's estimator almost always converges in 2 or 3 steps
+#define MAX_ESTIMATOR_ITERATIONS 5
+
 // Function to allocate memory for a square matrix
 double **allocateMatrix(int n)
 {
@@ -103,43 +114,221 @@ void backwardSubstitution(double **U, double *y, double *x, int n)
     }
 }
 
-// Invert matrix using LU decomposition
-void invertMatrix(double **A, double **A_inverse, int n)
+// Forward substitution with U^T (lower triangular), U is read column-wise
+void forwardSubstitutionTranspose(double **U, double *b, double *y, int n)
 {
-    double **L = allocateMatrix(n);
-    double **U = allocateMatrix(n);
-    LU_Decomposition(A, n, L, U);
+    for (int i = 0; i < n; i++)
+    {
+        y[i] = b[i];
+        for (int j = 0; j < i; j++)
+        {
+            y[i] -= U[j][i] * y[j];
+        }
+        y[i] /= U[i][i];
+    }
+}
 
-    double *b = malloc(n * sizeof(double));
-    double *y = malloc(n * sizeof(double));
+// Backward substitution with L^T (unit upper triangular), L is read column-wise
+void backwardSubstitutionTranspose(double **L, double *y, double *x, int n)
+{
+    for (int i = n - 1; i >= 0; i--)
+    {
+        x[i] = y[i];
+        for (int j = i + 1; j < n; j++)
+        {
+            x[i] -= L[j][i] * x[j];
+        }
+    }
+}
+
+// Hager / Higham estimate of the 1-norm condition number ||A||_1 * ||A^-1||_1
+// Reuses the L and U factors, only a few O(n^2) triangular solves with A and A^T are needed
+double estimateConditionNumber(double **A, double **L, double **U, int n)
+{
     double *x = malloc(n * sizeof(double));
+    double *y = malloc(n * sizeof(double));
+    double *z = malloc(n * sizeof(double));
+    double *w = malloc(n * sizeof(double));
+    double estimate = 0.0;
+
+    double A_norm = 0.0;
+    for (int j = 0; j < n; j++)
+    {
+        double sum = 0.0;
+        for (int i = 0; i < n; i++)
+        {
+            sum += fabs(A[i][j]);
+        }
+        if (sum > A_norm)
+        {
+            A_norm = sum;
+        }
+    }
 
     for (int i = 0; i < n; i++)
     {
-        // Set up identity matrix column
-        for (int j = 0; j < n; j++)
+        x[i] = 1.0 / n;
+    }
+
+    int previous_j = -1;
+    for (int iteration = 0; iteration < MAX_ESTIMATOR_ITERATIONS; iteration++)
+    {
+        // y = A^-1 x, ||y||_1 is a lower bound of ||A^-1||_1 (NaN when U has a zero pivot)
+        forwardSubstitution(L, x, w, n);
+        backwardSubstitution(U, w, y, n);
+        double norm = 0.0;
+        for (int i = 0; i < n; i++)
         {
-            b[j] = (i == j) ? 1.0 : 0.0;
+            norm += fabs(y[i]);
         }
+        if (isnan(norm))
+        {
+            estimate = norm;
+            break;
+        }
+        if (norm <= estimate)
+        {
+            break;
+        }
+        estimate = norm;
+
+        // z = A^-T sign(y), then restart from the unit vector where |z| is largest
+        for (int i = 0; i < n; i++)
+        {
+            y[i] = (y[i] >= 0.0) ? 1.0 : -1.0;
+        }
+        forwardSubstitutionTranspose(U, y, w, n);
+        backwardSubstitutionTranspose(L, w, z, n);
+        int j = 0;
+        double z_dot_x = 0.0;
+        for (int i = 0; i < n; i++)
+        {
+            z_dot_x += z[i] * x[i];
+            if (fabs(z[i]) > fabs(z[j]))
+            {
+                j = i;
+            }
+        }
+        if (fabs(z[j]) <= z_dot_x || j == previous_j)
+        {
+            break;
+        }
+        previous_j = j;
+        for (int i = 0; i < n; i++)
+        {
+            x[i] = (i == j) ? 1.0 : 0.0;
+        }
+    }
 
-        // Solve Ly = b
-        forwardSubstitution(L, b, y, n);
+    // Higham's alternating test vector
+    for (int i = 0; i < n; i++)
+    {
+        x[i] = ((i % 2) ? -1.0 : 1.0) * (1.0 + (n > 1 ? (double)i / (n - 1) : 0.0));
+    }
+    forwardSubstitution(L, x, w, n);
+    backwardSubstitution(U, w, y, n);
+    double alternative = 0.0;
+    for (int i = 0; i < n; i++)
+    {
+        alternative += fabs(y[i]);
+    }
+    alternative = 2.0 * alternative / (3.0 * n);
+    if (alternative > estimate)
+    {
+        estimate = alternative;
+    }
 
-        // Solve Ux = y
-        backwardSubstitution(U, y, x, n);
+    free(x);
+    free(y);
+    free(z);
+    free(w);
+    return A_norm * estimate;
+}
+
+// In-place inverse of the unit lower triangular matrix L (L^-1 is unit lower triangular as well)
+// Entry (i, j) only needs L[i][k] for k > j, which is still untouched when j runs upwards
+void invertLowerTriangular(double **L, int n)
+{
+    for (int i = 1; i < n; i++)
+    {
+        for (int j = 0; j < i; j++)
+        {
+            double sum = L[i][j];
+            for (int k = j + 1; k < i; k++)
+            {
+                sum += L[i][k] * L[k][j];
+            }
+            L[i][j] = -sum;
+        }
+    }
+}
 
-        // Store solution in the inverse matrix
+// In-place inverse of the upper triangular matrix U (U^-1 is upper triangular as well)
+// Rows are built from the bottom up, and each row from the right so U[i][k] (k < j) is still original
+void invertUpperTriangular(double **U, int n)
+{
+    for (int i = n - 1; i >= 0; i--)
+    {
+        for (int j = n - 1; j > i; j--)
+        {
+            double sum = 0.0;
+            for (int k = i + 1; k <= j; k++)
+            {
+                sum += U[i][k] * U[k][j];
+            }
+            U[i][j] = -sum / U[i][i];
+        }
+        U[i][i] = 1.0 / U[i][i];
+    }
+}
+
+// R = U^-1 * L^-1, skipping the zero triangles of both operands (k >= max(i, j))
+void multiplyUpperLower(double **U_inverse, double **L_inverse, double **R, int n)
+{
+    for (int i = 0; i < n; i++)
+    {
         for (int j = 0; j < n; j++)
         {
-            A_inverse[j][i] = x[j];
+            R[i][j] = 0.0;
+        }
+        for (int k = i; k < n; k++)
+        {
+            double factor = U_inverse[i][k];
+            for (int j = 0; j <= k; j++)
+            {
+                R[i][j] += factor * L_inverse[k][j];
+            }
         }
     }
+}
+
+// Invert matrix using LU decomposition
+// A^-1 = U^-1 * L^-1 (no row pivoting is done, so P = I), which costs about 2n^3 flops
+// instead of the 8n^3/3 needed by n forward and backward substitutions on identity columns
+// The estimated condition number is returned in condition, ill-conditioned inputs are rejected (FAILURE)
+// before the inversion work is spent on them
+int invertMatrix(double **A, double **A_inverse, int n, double *condition)
+{
+    double **L = allocateMatrix(n);
+    double **U = allocateMatrix(n);
+    LU_Decomposition(A, n, L, U);
+
+    *condition = estimateConditionNumber(A, L, U, n);
+    if (!(*condition <= MAX_CONDITION_NUMBER))
+    {
+        freeMatrix(L, n);
+        freeMatrix(U, n);
+        return FAILURE;
+    }
+
+    // L and U are overwritten by their own inverses
+    invertLowerTriangular(L, n);
+    invertUpperTriangular(U, n);
+    multiplyUpperLower(U, L, A_inverse, n);
 
     freeMatrix(L, n);
     freeMatrix(U, n);
-    free(b);
-    free(y);
-    free(x);
+    return SUCCESS;
 }
 
 // Function that request user to input Matrix elements
@@ -191,14 +380,23 @@ int main()
         }
     }*/
 
+    double condition;
     start_time = clock();
     // Step 4: Perform LU inversion
-    invertMatrix(A, A_inverse, n);
+    int status = invertMatrix(A, A_inverse, n, &condition);
     end_time = clock();
 
+    // Error condition 2
+    if (status == FAILURE)
+    {
+        printf("Matrix is singular or too ill-conditioned to be inverted (estimated condition number %.4e), the program will exit...", condition);
+        exit(1);
+    }
+
     // Step 5: Print results
     printMatrix("Matrix A", A, n);
     printMatrix("Matrix A Inverse", A_inverse, n);
+    printf("Estimated condition number (1-norm): %.4e\n", condition);
 
     printf("Time taken for LU Inversion Algorithm: %.6f seconds\n", (double)(end_time - start_time) / CLOCKS_PER_SEC);
 
@@ -0,0 +1,938 @@
+/*
+Group 03
+
+Hani Abdallah - 21400302
+Houssam Eddine Jamil Nasser - 21400407
+Tan Viet Nguyen - 21400381
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <time.h>
+
+// Iterative refinement gives up and falls back to a double factorization after this many steps
+#define MAX_REFINEMENT_ITERATIONS 30
+// Systems whose estimated condition number exceeds this are rejected, no digit of the solution can be trusted
+#define MAX_CONDITION_NUMBER (1.0 / DBL_EPSILON)
+// Hager's estimator almost always converges in 2 or 3 steps
+#define MAX_ESTIMATOR_ITERATIONS 5
+
+enum ERROR_CODES
+{
+    OK,
+    INCORRECT_MATRIX,
+    CALCULATION_ERROR
+};
+
+// Persistent LU factorization handle: P * A = L * U
+// L (unit diagonal, not stored) and U share the LU matrix, perm[i] is the row of A that ended up in row i
+// The 1-norm of A is kept so the condition number can be estimated from the factors alone
+typedef struct lu_factorization_struct
+{
+    double **LU;
+    int *perm;
+    int n;
+    double A_norm1;
+} lu_factorization_t;
+
+// Single precision copy of the factors for the mixed-precision solver
+typedef struct lu_factorization_float_struct
+{
+    float **LU;
+    int *perm;
+    int n;
+} lu_factorization_float_t;
+
+// One cached factorization, A is kept to rule out hash collisions
+typedef struct lu_cache_entry_struct
+{
+    unsigned long long hash;
+    double **A;
+    lu_factorization_t factorization;
+    unsigned long last_used;
+    int valid;
+} lu_cache_entry_t;
+
+// LRU cache of factorizations keyed by a content hash of A
+typedef struct lu_cache_struct
+{
+    lu_cache_entry_t *entries;
+    int capacity;
+    unsigned long clock;
+} lu_cache_t;
+
+// Function to allocate memory for a matrix
+double **allocateMatrix(int rows, int columns)
+{
+    double **matrix = malloc(rows * sizeof(double *));
+    for (int i = 0; i < rows; i++)
+    {
+        matrix[i] = malloc(columns * sizeof(double));
+    }
+    return matrix;
+}
+
+// Free allocated matrix memory
+void freeMatrix(double **matrix, int rows)
+{
+    for (int i = 0; i < rows; i++)
+    {
+        free(matrix[i]);
+    }
+    free(matrix);
+}
+
+// Copy Matrix A to Matrix B
+void copyMatrix(double **original_matrix, double **copied_matrix, int rows, int columns)
+{
+    for (int i = 0; i < rows; i++)
+    {
+        memcpy(copied_matrix[i], original_matrix[i], columns * sizeof(double));
+    }
+}
+
+// Function to print a matrix
+void printMatrix(const char *name, double **matrix, int rows, int columns)
+{
+    printf("%s:\n", name);
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < columns; j++)
+        {
+            printf("%10.4f ", matrix[i][j]);
+        }
+        printf("\n");
+    }
+}
+
+// LU factorization with partial pivoting, A is left untouched
+// Row swaps only exchange row pointers, so they cost O(1) each
+int LU_Factorize(double **A, int n, lu_factorization_t *factorization)
+{
+    if (A == NULL || factorization == NULL || n < 1)
+    {
+        return INCORRECT_MATRIX;
+    }
+
+    double **LU = allocateMatrix(n, n);
+    int *perm = malloc(n * sizeof(int));
+    copyMatrix(A, LU, n, n);
+    for (int i = 0; i < n; i++)
+    {
+        perm[i] = i;
+    }
+
+    // 1-norm (maximum absolute column sum) of A, O(n^2)
+    double *column_sums = calloc(n, sizeof(double));
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            column_sums[j] += fabs(A[i][j]);
+        }
+    }
+    factorization->A_norm1 = 0.0;
+    for (int j = 0; j < n; j++)
+    {
+        if (column_sums[j] > factorization->A_norm1)
+        {
+            factorization->A_norm1 = column_sums[j];
+        }
+    }
+    free(column_sums);
+
+    int status = OK;
+    for (int k = 0; k < n && status == OK; k++)
+    {
+        // Pivot: largest entry of column k on or below the diagonal
+        int pivot = k;
+        for (int i = k + 1; i < n; i++)
+        {
+            if (fabs(LU[i][k]) > fabs(LU[pivot][k]))
+            {
+                pivot = i;
+            }
+        }
+        if (LU[pivot][k] == 0.0)
+        {
+            status = CALCULATION_ERROR;
+            break;
+        }
+        if (pivot != k)
+        {
+            double *row = LU[k];
+            LU[k] = LU[pivot];
+            LU[pivot] = row;
+            int index = perm[k];
+            perm[k] = perm[pivot];
+            perm[pivot] = index;
+        }
+
+        for (int i = k + 1; i < n; i++)
+        {
+            double factor = LU[i][k] / LU[k][k];
+            LU[i][k] = factor;
+            for (int j = k + 1; j < n; j++)
+            {
+                LU[i][j] -= factor * LU[k][j];
+            }
+        }
+    }
+
+    factorization->LU = LU;
+    factorization->perm = perm;
+    factorization->n = n;
+    return status;
+}
+
+void LU_FreeFactorization(lu_factorization_t *factorization)
+{
+    if (factorization != NULL && factorization->LU != NULL)
+    {
+        freeMatrix(factorization->LU, factorization->n);
+        free(factorization->perm);
+        factorization->LU = NULL;
+        factorization->perm = NULL;
+    }
+}
+
+// Solve A x = b with an existing factorization in O(n^2), b and x must be different vectors
+void LU_Solve(lu_factorization_t *factorization, double *b, double *x)
+{
+    int n = factorization->n;
+    double **LU = factorization->LU;
+
+    // Forward substitution: L y = P b
+    for (int i = 0; i < n; i++)
+    {
+        double sum = b[factorization->perm[i]];
+        for (int j = 0; j < i; j++)
+        {
+            sum -= LU[i][j] * x[j];
+        }
+        x[i] = sum;
+    }
+
+    // Backward substitution: U x = y
+    for (int i = n - 1; i >= 0; i--)
+    {
+        double sum = x[i];
+        for (int j = i + 1; j < n; j++)
+        {
+            sum -= LU[i][j] * x[j];
+        }
+        x[i] = sum / LU[i][i];
+    }
+}
+
+// Solve A^T x = b with an existing factorization: U^T z = b, L^T w = z, x = P^T w
+void LU_SolveTranspose(lu_factorization_t *factorization, double *b, double *x)
+{
+    int n = factorization->n;
+    double **LU = factorization->LU;
+    double *w = malloc(n * sizeof(double));
+
+    // U^T is lower triangular, walk the columns of U
+    for (int i = 0; i < n; i++)
+    {
+        double sum = b[i];
+        for (int j = 0; j < i; j++)
+        {
+            sum -= LU[j][i] * w[j];
+        }
+        w[i] = sum / LU[i][i];
+    }
+
+    // L^T is unit upper triangular
+    for (int i = n - 1; i >= 0; i--)
+    {
+        double sum = w[i];
+        for (int j = i + 1; j < n; j++)
+        {
+            sum -= LU[j][i] * w[j];
+        }
+        w[i] = sum;
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        x[factorization->perm[i]] = w[i];
+    }
+    free(w);
+}
+
+// Hager / Higham estimate of ||A^-1||_1 from the factors, a handful of O(n^2) solves with A and A^T
+double LU_EstimateInverseNorm1(lu_factorization_t *factorization)
+{
+    int n = factorization->n;
+    double *x = malloc(n * sizeof(double));
+    double *y = malloc(n * sizeof(double));
+    double *z = malloc(n * sizeof(double));
+    double estimate = 0.0;
+
+    for (int i = 0; i < n; i++)
+    {
+        x[i] = 1.0 / n;
+    }
+
+    int previous_j = -1;
+    for (int iteration = 0; iteration < MAX_ESTIMATOR_ITERATIONS; iteration++)
+    {
+        // y = A^-1 x, ||y||_1 is a lower bound of ||A^-1||_1
+        LU_Solve(factorization, x, y);
+        double norm = 0.0;
+        for (int i = 0; i < n; i++)
+        {
+            norm += fabs(y[i]);
+        }
+        if (norm <= estimate)
+        {
+            break;
+        }
+        estimate = norm;
+
+        // z = A^-T sign(y) is a subgradient, move to the unit vector where it is largest
+        for (int i = 0; i < n; i++)
+        {
+            y[i] = (y[i] >= 0.0) ? 1.0 : -1.0;
+        }
+        LU_SolveTranspose(factorization, y, z);
+        int j = 0;
+        double z_dot_x = 0.0;
+        for (int i = 0; i < n; i++)
+        {
+            z_dot_x += z[i] * x[i];
+            if (fabs(z[i]) > fabs(z[j]))
+            {
+                j = i;
+            }
+        }
+        if (fabs(z[j]) <= z_dot_x || j == previous_j)
+        {
+            break;
+        }
+        previous_j = j;
+        for (int i = 0; i < n; i++)
+        {
+            x[i] = (i == j) ? 1.0 : 0.0;
+        }
+    }
+
+    // Higham's extra test vector with alternating signs catches the cases Hager's iteration misses
+    for (int i = 0; i < n; i++)
+    {
+        x[i] = ((i % 2) ? -1.0 : 1.0) * (1.0 + (n > 1 ? (double)i / (n - 1) : 0.0));
+    }
+    LU_Solve(factorization, x, y);
+    double alternative = 0.0;
+    for (int i = 0; i < n; i++)
+    {
+        alternative += fabs(y[i]);
+    }
+    alternative = 2.0 * alternative / (3.0 * n);
+    if (alternative > estimate)
+    {
+        estimate = alternative;
+    }
+
+    free(x);
+    free(y);
+    free(z);
+    return estimate;
+}
+
+// Estimated 1-norm condition number ||A||_1 * ||A^-1||_1, at O(n^2) cost on top of the factorization
+double LU_ConditionNumber(lu_factorization_t *factorization)
+{
+    return factorization->A_norm1 * LU_EstimateInverseNorm1(factorization);
+}
+
+// log|det(A)| from the factors: det(P) * det(L) * det(U) with det(L) = 1
+// Summing logs of the pivots never overflows, even when det(A) itself is far outside the double range
+// The sign of det(A) is returned in sign (0 for a singular matrix, together with -HUGE_VAL)
+double LU_LogDeterminant(lu_factorization_t *factorization, int *sign)
+{
+    int n = factorization->n;
+    double log_abs_det = 0.0;
+    *sign = 1;
+
+    for (int i = 0; i < n; i++)
+    {
+        double pivot = factorization->LU[i][i];
+        if (pivot == 0.0)
+        {
+            *sign = 0;
+            return -HUGE_VAL;
+        }
+        if (pivot < 0.0)
+        {
+            *sign = -*sign;
+        }
+        log_abs_det += log(fabs(pivot));
+    }
+
+    // det(P) = (-1)^(n - number of cycles of the permutation)
+    // Visited entries are marked by storing -(perm[j] + 1), then restored
+    int *perm = factorization->perm;
+    int cycles = 0;
+    for (int i = 0; i < n; i++)
+    {
+        if (perm[i] >= 0)
+        {
+            cycles++;
+            for (int j = i; perm[j] >= 0;)
+            {
+                int next = perm[j];
+                perm[j] = -(next + 1);
+                j = next;
+            }
+        }
+    }
+    for (int i = 0; i < n; i++)
+    {
+        perm[i] = -perm[i] - 1;
+    }
+    if ((n - cycles) % 2)
+    {
+        *sign = -*sign;
+    }
+
+    return log_abs_det;
+}
+
+// det(A) from the factors, +-HUGE_VAL or 0 when it falls outside the double range
+double LU_Determinant(lu_factorization_t *factorization)
+{
+    int sign;
+    double log_abs_det = LU_LogDeterminant(factorization, &sign);
+    return sign * exp(log_abs_det);
+}
+
+// Solve A X = B for nrhs right-hand sides stored as the columns of the n x nrhs matrix B
+// Whole rows of X are updated at once so every sweep over the factors serves the full batch
+void LU_SolveBatch(lu_factorization_t *factorization, double **B, double **X, int nrhs)
+{
+    int n = factorization->n;
+    double **LU = factorization->LU;
+
+    for (int i = 0; i < n; i++)
+    {
+        memcpy(X[i], B[factorization->perm[i]], nrhs * sizeof(double));
+        for (int k = 0; k < i; k++)
+        {
+            double factor = LU[i][k];
+            for (int j = 0; j < nrhs; j++)
+            {
+                X[i][j] -= factor * X[k][j];
+            }
+        }
+    }
+
+    for (int i = n - 1; i >= 0; i--)
+    {
+        for (int k = i + 1; k < n; k++)
+        {
+            double factor = LU[i][k];
+            for (int j = 0; j < nrhs; j++)
+            {
+                X[i][j] -= factor * X[k][j];
+            }
+        }
+        for (int j = 0; j < nrhs; j++)
+        {
+            X[i][j] /= LU[i][i];
+        }
+    }
+}
+
+// Same factorization as LU_Factorize, but carried out in single precision
+// The O(n^3) elimination then moves half the bytes and fits twice as many lanes per SIMD register
+int LU_FactorizeFloat(double **A, int n, lu_factorization_float_t *factorization)
+{
+    if (A == NULL || factorization == NULL || n < 1)
+    {
+        return INCORRECT_MATRIX;
+    }
+
+    float **LU = malloc(n * sizeof(float *));
+    int *perm = malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++)
+    {
+        LU[i] = malloc(n * sizeof(float));
+        for (int j = 0; j < n; j++)
+        {
+            LU[i][j] = (float)A[i][j];
+        }
+        perm[i] = i;
+    }
+
+    int status = OK;
+    for (int k = 0; k < n && status == OK; k++)
+    {
+        int pivot = k;
+        for (int i = k + 1; i < n; i++)
+        {
+            if (fabsf(LU[i][k]) > fabsf(LU[pivot][k]))
+            {
+                pivot = i;
+            }
+        }
+        if (LU[pivot][k] == 0.0f)
+        {
+            status = CALCULATION_ERROR;
+            break;
+        }
+        if (pivot != k)
+        {
+            float *row = LU[k];
+            LU[k] = LU[pivot];
+            LU[pivot] = row;
+            int index = perm[k];
+            perm[k] = perm[pivot];
+            perm[pivot] = index;
+        }
+
+        for (int i = k + 1; i < n; i++)
+        {
+            float factor = LU[i][k] / LU[k][k];
+            LU[i][k] = factor;
+            for (int j = k + 1; j < n; j++)
+            {
+                LU[i][j] -= factor * LU[k][j];
+            }
+        }
+    }
+
+    factorization->LU = LU;
+    factorization->perm = perm;
+    factorization->n = n;
+    return status;
+}
+
+void LU_FreeFactorizationFloat(lu_factorization_float_t *factorization)
+{
+    if (factorization != NULL && factorization->LU != NULL)
+    {
+        for (int i = 0; i < factorization->n; i++)
+        {
+            free(factorization->LU[i]);
+        }
+        free(factorization->LU);
+        free(factorization->perm);
+        factorization->LU = NULL;
+        factorization->perm = NULL;
+    }
+}
+
+// Solve A x = b with the single precision factors, b and x must be different vectors
+void LU_SolveFloat(lu_factorization_float_t *factorization, double *b, double *x)
+{
+    int n = factorization->n;
+    float **LU = factorization->LU;
+
+    for (int i = 0; i < n; i++)
+    {
+        double sum = b[factorization->perm[i]];
+        for (int j = 0; j < i; j++)
+        {
+            sum -= LU[i][j] * x[j];
+        }
+        x[i] = sum;
+    }
+
+    for (int i = n - 1; i >= 0; i--)
+    {
+        double sum = x[i];
+        for (int j = i + 1; j < n; j++)
+        {
+            sum -= LU[i][j] * x[j];
+        }
+        x[i] = sum / LU[i][i];
+    }
+}
+
+// Infinity norm of a vector
+double vectorNorm(double *x, int n)
+{
+    double norm = 0.0;
+    for (int i = 0; i < n; i++)
+    {
+        if (fabs(x[i]) > norm)
+        {
+            norm = fabs(x[i]);
+        }
+    }
+    return norm;
+}
+
+// Infinity norm (maximum absolute row sum) of a matrix
+double matrixNorm(double **A, int n)
+{
+    double norm = 0.0;
+    for (int i = 0; i < n; i++)
+    {
+        double sum = 0.0;
+        for (int j = 0; j < n; j++)
+        {
+            sum += fabs(A[i][j]);
+        }
+        if (sum > norm)
+        {
+            norm = sum;
+        }
+    }
+    return norm;
+}
+
+// Iterative refinement of x towards the double precision solution of A x = b
+// The residual is formed in double, the correction is solved with the float factors
+// Returns the number of refinement steps, or -1 if the corrections stopped shrinking
+int LU_RefineSolution(double **A, lu_factorization_float_t *factorization, double A_norm, double *b, double *x)
+{
+    int n = factorization->n;
+    double *r = malloc(n * sizeof(double));
+    double *d = malloc(n * sizeof(double));
+    double tolerance = A_norm * DBL_EPSILON * sqrt((double)n);
+    double previous_correction = HUGE_VAL;
+    int iterations = -1;
+
+    for (int iteration = 0; iteration <= MAX_REFINEMENT_ITERATIONS; iteration++)
+    {
+        // r = b - A x in double precision
+        for (int i = 0; i < n; i++)
+        {
+            double sum = b[i];
+            for (int j = 0; j < n; j++)
+            {
+                sum -= A[i][j] * x[j];
+            }
+            r[i] = sum;
+        }
+        if (vectorNorm(r, n) <= tolerance * vectorNorm(x, n))
+        {
+            iterations = iteration;
+            break;
+        }
+
+        LU_SolveFloat(factorization, r, d);
+        double correction = vectorNorm(d, n);
+        // Refinement converges linearly, a correction that does not halve means it has stalled
+        if (!isfinite(correction) || correction > 0.5 * previous_correction)
+        {
+            break;
+        }
+        previous_correction = correction;
+        for (int i = 0; i < n; i++)
+        {
+            x[i] += d[i];
+        }
+    }
+
+    free(r);
+    free(d);
+    return iterations;
+}
+
+// Mixed-precision solve of A X = B: single precision LU, then refinement to double accuracy
+// Columns whose refinement stalls are solved again with a full double factorization
+// Returns the number of right-hand sides that needed the fallback, or -1 if A is singular
+int LU_SolveBatchMixedPrecision(double **A, int n, double **B, double **X, int nrhs)
+{
+    lu_factorization_float_t factorization_float;
+    lu_factorization_t factorization;
+    factorization.LU = NULL;
+    int fallbacks = 0;
+    int float_status = LU_FactorizeFloat(A, n, &factorization_float);
+    double A_norm = matrixNorm(A, n);
+
+    double *b = malloc(n * sizeof(double));
+    double *x = malloc(n * sizeof(double));
+
+    for (int j = 0; j < nrhs && fallbacks >= 0; j++)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            b[i] = B[i][j];
+        }
+
+        int iterations = -1;
+        if (float_status == OK)
+        {
+            LU_SolveFloat(&factorization_float, b, x);
+            iterations = LU_RefineSolution(A, &factorization_float, A_norm, b, x);
+        }
+        if (iterations < 0)
+        {
+            // The double factorization is computed once, on the first column that needs it
+            if (factorization.LU == NULL && LU_Factorize(A, n, &factorization) != OK)
+            {
+                fallbacks = -1;
+                break;
+            }
+            LU_Solve(&factorization, b, x);
+            fallbacks++;
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            X[i][j] = x[i];
+        }
+    }
+
+    LU_FreeFactorizationFloat(&factorization_float);
+    LU_FreeFactorization(&factorization);
+    free(b);
+    free(x);
+    return fallbacks;
+}
+
+// FNV-1a hash over the dimension and the raw bytes of the matrix
+unsigned long long hashMatrix(double **A, int n)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+    const unsigned char *bytes = (const unsigned char *)&n;
+    for (size_t b = 0; b < sizeof(int); b++)
+    {
+        hash = (hash ^ bytes[b]) * 1099511628211ULL;
+    }
+    for (int i = 0; i < n; i++)
+    {
+        bytes = (const unsigned char *)A[i];
+        for (size_t b = 0; b < n * sizeof(double); b++)
+        {
+            hash = (hash ^ bytes[b]) * 1099511628211ULL;
+        }
+    }
+    return hash;
+}
+
+// Create an empty cache holding up to capacity factorizations, capacity has to be at least 1
+int LU_CacheCreate(lu_cache_t *cache, int capacity)
+{
+    cache->entries = NULL;
+    cache->capacity = 0;
+    cache->clock = 0;
+    if (capacity < 1)
+    {
+        return INCORRECT_MATRIX;
+    }
+
+    cache->entries = calloc(capacity, sizeof(lu_cache_entry_t));
+    if (cache->entries == NULL)
+    {
+        return INCORRECT_MATRIX;
+    }
+    cache->capacity = capacity;
+    return OK;
+}
+
+void LU_CacheFree(lu_cache_t *cache)
+{
+    for (int e = 0; e < cache->capacity; e++)
+    {
+        if (cache->entries[e].valid)
+        {
+            freeMatrix(cache->entries[e].A, cache->entries[e].factorization.n);
+            LU_FreeFactorization(&cache->entries[e].factorization);
+        }
+    }
+    free(cache->entries);
+    cache->entries = NULL;
+    cache->capacity = 0;
+}
+
+// Return the factorization of A, computing it only on a cache miss
+// The least recently used entry is evicted when the cache is full, NULL is returned if A is singular
+// The returned pointer is owned by the cache: it stays valid only until a later lookup evicts its entry
+// or LU_CacheFree is called, so use it before the next lookup or copy what is needed
+lu_factorization_t *LU_CacheLookup(lu_cache_t *cache, double **A, int n)
+{
+    if (cache->capacity < 1)
+    {
+        return NULL;
+    }
+
+    unsigned long long hash = hashMatrix(A, n);
+    cache->clock++;
+
+    int victim = 0;
+    for (int e = 0; e < cache->capacity; e++)
+    {
+        lu_cache_entry_t *entry = &cache->entries[e];
+        if (entry->valid && entry->hash == hash && entry->factorization.n == n)
+        {
+            int same = 1;
+            for (int i = 0; i < n && same; i++)
+            {
+                same = memcmp(entry->A[i], A[i], n * sizeof(double)) == 0;
+            }
+            if (same)
+            {
+                entry->last_used = cache->clock;
+                return &entry->factorization;
+            }
+        }
+        if (!entry->valid || (cache->entries[victim].valid && entry->last_used < cache->entries[victim].last_used))
+        {
+            victim = e;
+        }
+    }
+
+    lu_factorization_t factorization;
+    if (LU_Factorize(A, n, &factorization) != OK)
+    {
+        LU_FreeFactorization(&factorization);
+        return NULL;
+    }
+
+    lu_cache_entry_t *entry = &cache->entries[victim];
+    if (entry->valid)
+    {
+        freeMatrix(entry->A, entry->factorization.n);
+        LU_FreeFactorization(&entry->factorization);
+    }
+    entry->A = allocateMatrix(n, n);
+    copyMatrix(A, entry->A, n, n);
+    entry->hash = hash;
+    entry->factorization = factorization;
+    entry->last_used = cache->clock;
+    entry->valid = 1;
+    return &entry->factorization;
+}
+
+// Function that request user to input Matrix elements
+void RequestInput(const char *name, double **matrix, int rows, int columns)
+{
+    printf("Input Matrix %s Elements:\n", name);
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < columns; j++)
+        {
+            printf("%s[%d][%d]=", name, i, j);
+            scanf("%lf", &matrix[i][j]);
+        }
+    }
+}
+
+int main()
+{
+    clock_t start_time, end_time;
+    int n, nrhs, mode;
+
+    // Step 1: Get dimensions for Matrix A, the number of right-hand sides and the solver mode
+    printf("\nChoose Matrix Dimension for the square matrix: ");
+    scanf("%d", &n);
+    printf("\nChoose the number of right-hand sides: ");
+    scanf("%d", &nrhs);
+    printf("\nChoose the solver mode (1: double precision LU, 2: mixed precision LU with iterative refinement): ");
+    scanf("%d", &mode);
+
+    // Error condition 1
+    if (n <= 0 || nrhs <= 0)
+    {
+        printf("Matrix Size can only be larger than zero, the program will exit...");
+        exit(1);
+    }
+
+    // Error condition 2
+    if (mode != 1 && mode != 2)
+    {
+        printf("Solver mode can only be 1 or 2, the program will exit...");
+        exit(1);
+    }
+
+    // Step 2: Allocate matrices memory
+    double **A = allocateMatrix(n, n);
+    double **B = allocateMatrix(n, nrhs);
+    double **X = allocateMatrix(n, nrhs);
+
+    // Note: You can either enter the matrix input manually, or choose to fill the matrices automatically. But make sure to comment "RequestInput" function calls, and to uncomment the alternative random input option.
+    // Step 3: Asking the user to input Matrix A and the right-hand sides B (one per column)
+    RequestInput("A", A, n, n);
+    RequestInput("B", B, n, nrhs);
+
+    // This is an alternative random input option, but make sure to comment "RequestInput" function calls.
+    /*for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            A[i][j] = (i == j) ? 1.0 : ((double)rand() / RAND_MAX);
+        }
+        for (int j = 0; j < nrhs; j++)
+        {
+            B[i][j] = (double)rand() / RAND_MAX;
+        }
+    }*/
+
+    lu_cache_t cache;
+    if (LU_CacheCreate(&cache, 4) != OK)
+    {
+        printf("Could not allocate the factorization cache, the program will exit...");
+        exit(1);
+    }
+
+    if (mode == 1)
+    {
+        // Step 4: Factorize A once through the cache
+        start_time = clock();
+        lu_factorization_t *factorization = LU_CacheLookup(&cache, A, n);
+        end_time = clock();
+
+        if (factorization == NULL)
+        {
+            printf("Matrix is singular, the program will exit...");
+            exit(1);
+        }
+        printf("Time taken for LU Factorization: %.6f seconds\n", (double)(end_time - start_time) / CLOCKS_PER_SEC);
+
+        // Error condition 3: reject the system before solving if no digit of the solution can be trusted
+        double condition = LU_ConditionNumber(factorization);
+        printf("Estimated condition number (1-norm): %.4e\n", condition);
+        if (condition > MAX_CONDITION_NUMBER)
+        {
+            printf("Matrix is too ill-conditioned to be solved, the program will exit...");
+            exit(1);
+        }
+
+        int sign;
+        double log_abs_det = LU_LogDeterminant(factorization, &sign);
+        printf("Determinant: %.6e (sign %d, log|det| = %.6f)\n", LU_Determinant(factorization), sign, log_abs_det);
+
+        // Step 5: Solve for all right-hand sides, a second lookup of the same A hits the cache
+        start_time = clock();
+        factorization = LU_CacheLookup(&cache, A, n);
+        LU_SolveBatch(factorization, B, X, nrhs);
+        end_time = clock();
+    }
+    else
+    {
+        // Step 4 and 5: Single precision factorization, refined to double accuracy for every right-hand side
+        start_time = clock();
+        int fallbacks = LU_SolveBatchMixedPrecision(A, n, B, X, nrhs);
+        end_time = clock();
+
+        if (fallbacks < 0)
+        {
+            printf("Matrix is singular, the program will exit...");
+            exit(1);
+        }
+        printf("Right-hand sides solved again in double precision after refinement stalled: %d\n", fallbacks);
+    }
+
+    // Step 6: Print results
+    printMatrix("Matrix A", A, n, n);
+    printMatrix("Solution X", X, n, nrhs);
+    printf("Time taken for the %d solves: %.6f seconds\n", nrhs, (double)(end_time - start_time) / CLOCKS_PER_SEC);
+
+    // Step 7: Free memory
+    LU_CacheFree(&cache);
+    freeMatrix(A, n);
+    freeMatrix(B, n);
+    freeMatrix(X, n);
+
+    return 0;
+}
@@ -0,0 +1,395 @@
+/*
+Group 03
+
+Hani Abdallah - 21400302
+Houssam Eddine Jamil Nasser - 21400407
+Tan Viet Nguyen - 21400381
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Tiles are TILE_SIZE x TILE_SIZE blocks stored contiguously, edge tiles are partially used
+#define TILE_SIZE 128
+
+enum ERROR_CODES
+{
+    OK,
+    INCORRECT_MATRIX,
+    CALCULATION_ERROR
+};
+
+// Matrix stored as nt x nt contiguous tiles, tile (I, J) starts at tiles[I * nt + J]
+typedef struct tile_matrix_struct
+{
+    double **tiles;
+    int n;
+    int nb;
+    int nt;
+} tile_matrix_t;
+
+// allocate memory for matrices
+double **allocateMatrix(int n)
+{
+    double **matrix = (double **)malloc(n * sizeof(double *));
+    for (int i = 0; i < n; i++)
+    {
+        matrix[i] = (double *)malloc(n * sizeof(double));
+    }
+    return matrix;
+}
+
+// free allocated memory of matrices
+void freeMatrix(double **matrix, int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        free(matrix[i]);
+    }
+    free(matrix);
+}
+
+// Number of rows (or columns) actually used in tile row (or column) I
+int tileDimension(tile_matrix_t *T, int I)
+{
+    return (I == T->nt - 1) ? T->n - I * T->nb : T->nb;
+}
+
+// Copy a row-pointer matrix into tile layout
+void toTiles(double **A, int n, int nb, tile_matrix_t *T)
+{
+    T->n = n;
+    T->nb = nb;
+    T->nt = (n + nb - 1) / nb;
+    T->tiles = malloc(T->nt * T->nt * sizeof(double *));
+    for (int I = 0; I < T->nt; I++)
+    {
+        for (int J = 0; J < T->nt; J++)
+        {
+            double *tile = calloc(nb * nb, sizeof(double));
+            for (int i = 0; i < tileDimension(T, I); i++)
+            {
+                memcpy(&tile[i * nb], &A[I * nb + i][J * nb], tileDimension(T, J) * sizeof(double));
+            }
+            T->tiles[I * T->nt + J] = tile;
+        }
+    }
+}
+
+// Copy a tile layout matrix back into a row-pointer matrix
+void fromTiles(tile_matrix_t *T, double **A)
+{
+    int nb = T->nb;
+    for (int I = 0; I < T->nt; I++)
+    {
+        for (int J = 0; J < T->nt; J++)
+        {
+            for (int i = 0; i < tileDimension(T, I); i++)
+            {
+                memcpy(&A[I * nb + i][J * nb], &T->tiles[I * T->nt + J][i * nb], tileDimension(T, J) * sizeof(double));
+            }
+        }
+    }
+}
+
+void freeTiles(tile_matrix_t *T)
+{
+    for (int t = 0; t < T->nt * T->nt; t++)
+    {
+        free(T->tiles[t]);
+    }
+    free(T->tiles);
+}
+
+// Swap global rows r1 and r2 inside tile column J
+void swapTileRows(tile_matrix_t *T, int r1, int r2, int J)
+{
+    int nb = T->nb;
+    double *row1 = &T->tiles[(r1 / nb) * T->nt + J][(r1 % nb) * nb];
+    double *row2 = &T->tiles[(r2 / nb) * T->nt + J][(r2 % nb) * nb];
+    for (int j = 0; j < tileDimension(T, J); j++)
+    {
+        double temp = row1[j];
+        row1[j] = row2[j];
+        row2[j] = temp;
+    }
+}
+
+// getrf: partial pivoting LU of the tile column k (rows k*nb .. n-1)
+// ipiv[g] is the global row swapped with row g, singular is raised on a zero pivot
+void panelFactorization(tile_matrix_t *T, int k, int *ipiv, int *singular)
+{
+    int nb = T->nb;
+    int nt = T->nt;
+    int width = tileDimension(T, k);
+
+    for (int c = 0; c < width; c++)
+    {
+        int g = k * nb + c;
+
+        int pivot = g;
+        double pivot_value = 0.0;
+        for (int r = g; r < T->n; r++)
+        {
+            double value = fabs(T->tiles[(r / nb) * nt + k][(r % nb) * nb + c]);
+            if (value > pivot_value)
+            {
+                pivot_value = value;
+                pivot = r;
+            }
+        }
+        ipiv[g] = pivot;
+        if (pivot_value == 0.0)
+        {
+            *singular = 1;
+            continue;
+        }
+        if (pivot != g)
+        {
+            swapTileRows(T, g, pivot, k);
+        }
+
+        // Scale the column below the pivot and update the rest of the panel
+        double *pivot_row = &T->tiles[k * nt + k][c * nb];
+        for (int r = g + 1; r < T->n; r++)
+        {
+            double *row = &T->tiles[(r / nb) * nt + k][(r % nb) * nb];
+            double factor = row[c] / pivot_row[c];
+            row[c] = factor;
+            for (int j = c + 1; j < width; j++)
+            {
+                row[j] -= factor * pivot_row[j];
+            }
+        }
+    }
+}
+
+// laswp + trsm: apply the row swaps of panel k to tile column j, then A_kj = L_kk^-1 * A_kj
+void swapAndSolve(tile_matrix_t *T, int k, int j, int *ipiv)
+{
+    int nb = T->nb;
+    double *L = T->tiles[k * T->nt + k];
+    double *B = T->tiles[k * T->nt + j];
+    int rows = tileDimension(T, k);
+    int columns = tileDimension(T, j);
+
+    for (int c = 0; c < rows; c++)
+    {
+        int g = k * nb + c;
+        if (ipiv[g] != g)
+        {
+            swapTileRows(T, g, ipiv[g], j);
+        }
+    }
+
+    for (int i = 1; i < rows; i++)
+    {
+        for (int p = 0; p < i; p++)
+        {
+            double factor = L[i * nb + p];
+            for (int c = 0; c < columns; c++)
+            {
+                B[i * nb + c] -= factor * B[p * nb + c];
+            }
+        }
+    }
+}
+
+// gemm: A_ij -= A_ik * A_kj
+void tileUpdate(tile_matrix_t *T, int i, int j, int k)
+{
+    int nb = T->nb;
+    double *restrict C = T->tiles[i * T->nt + j];
+    const double *restrict A = T->tiles[i * T->nt + k];
+    const double *restrict B = T->tiles[k * T->nt + j];
+    int rows = tileDimension(T, i);
+    int inner = tileDimension(T, k);
+    int columns = tileDimension(T, j);
+
+    for (int r = 0; r < rows; r++)
+    {
+        for (int p = 0; p < inner; p++)
+        {
+            double factor = A[r * nb + p];
+            for (int c = 0; c < columns; c++)
+            {
+                C[r * nb + c] -= factor * B[p * nb + c];
+            }
+        }
+    }
+}
+
+// Parallel tile LU with partial pivoting: P * A = L * U
+// Every getrf / swap+trsm / gemm on tiles is a task, the OpenMP runtime starts a task as soon as
+// the tiles it reads and writes are ready, so the trailing updates of step k overlap the panel of step k + 1
+int LU_TileDecomposition(double **A, int n, double **LU, int *ipiv)
+{
+    if (A == NULL || LU == NULL || ipiv == NULL || n < 1)
+    {
+        return INCORRECT_MATRIX;
+    }
+
+    tile_matrix_t T;
+    toTiles(A, n, TILE_SIZE, &T);
+    int nt = T.nt;
+    int singular = 0;
+
+#pragma omp parallel
+#pragma omp single
+    {
+        for (int k = 0; k < nt; k++)
+        {
+#pragma omp task depend(iterator(i = k : nt), inout : T.tiles[i * nt + k][0]) priority(1)
+            panelFactorization(&T, k, ipiv, &singular);
+
+            for (int j = k + 1; j < nt; j++)
+            {
+#pragma omp task depend(in : T.tiles[k * nt + k][0]) depend(iterator(i = k : nt), inout : T.tiles[i * nt + j][0])
+                swapAndSolve(&T, k, j, ipiv);
+
+                for (int i = k + 1; i < nt; i++)
+                {
+#pragma omp task depend(in : T.tiles[i * nt + k][0], T.tiles[k * nt + j][0]) depend(inout : T.tiles[i * nt + j][0])
+                    tileUpdate(&T, i, j, k);
+                }
+            }
+        }
+    }
+
+    // Swaps of later panels still have to reach the columns of L left of them, O(n^2) in total
+    for (int k = 1; k < nt; k++)
+    {
+        for (int g = k * T.nb; g < k * T.nb + tileDimension(&T, k); g++)
+        {
+            if (ipiv[g] != g)
+            {
+                for (int J = 0; J < k; J++)
+                {
+                    swapTileRows(&T, g, ipiv[g], J);
+                }
+            }
+        }
+    }
+
+    fromTiles(&T, LU);
+    freeTiles(&T);
+    return singular ? CALCULATION_ERROR : OK;
+}
+
+// Print the unit lower factor stored below the diagonal of LU
+void printLower(const char *name, double **LU, int n)
+{
+    printf("%s:\n", name);
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            printf("%.3f\t", (j < i) ? LU[i][j] : ((i == j) ? 1.0 : 0.0));
+        }
+        printf("\n");
+    }
+}
+
+// Print the upper factor stored on and above the diagonal of LU
+void printUpper(const char *name, double **LU, int n)
+{
+    printf("%s:\n", name);
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            printf("%.3f\t", (j >= i) ? LU[i][j] : 0.0);
+        }
+        printf("\n");
+    }
+}
+
+// Function that request user to input Matrix elements
+void RequestInput(const char *name, double **matrix, int n)
+{
+    printf("Input Matrix %s Elements:\n", name);
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            printf("%s[%d][%d]=", name, i, j);
+            scanf("%lf", &matrix[i][j]);
+        }
+    }
+}
+
+int main()
+{
+    int n;
+
+    // Step 1: Get dimensions for Matrix A
+    printf("\nChoose Matrix Dimension for the square matrix: ");
+    scanf("%d", &n);
+
+    // Error condition
+    if (n <= 0)
+    {
+        printf("Matrix Size can only be larger than zero, the program will exit...");
+        exit(1);
+    }
+
+    // Step 2: Allocate matrices memory
+    double **A = allocateMatrix(n);
+    double **LU = allocateMatrix(n);
+    int *ipiv = malloc(n * sizeof(int));
+
+    // Note: You can either enter the matrix input manually, or choose to fill the matrices automatically. But make sure to comment "RequestInput" function calls, and to uncomment the alternative random input option.
+    // Step 3: Asking the user to input Matrix A elements
+    RequestInput("A", A, n);
+
+    // This is an alternative random input option, but make sure to comment "RequestInput" function calls.
+    /*for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            A[i][j] = (i == j) ? 1.0 : ((double)rand() / RAND_MAX);
+        }
+    }*/
+
+    // Step 4: Perform the tile LU decomposition, timed on the wall clock since the work is spread over threads
+    struct timespec start_time, end_time;
+    timespec_get(&start_time, TIME_UTC);
+    int status = LU_TileDecomposition(A, n, LU, ipiv);
+    timespec_get(&end_time, TIME_UTC);
+
+    if (status != OK)
+    {
+        printf("Matrix is singular, the program will exit...");
+        exit(1);
+    }
+
+#ifdef _OPENMP
+    printf("Threads used: %d\n", omp_get_max_threads());
+#endif
+    printf("Time taken for Tile LU Decomposition Algorithm: %.6f seconds\n",
+           (double)(end_time.tv_sec - start_time.tv_sec) + (double)(end_time.tv_nsec - start_time.tv_nsec) / 1e9);
+
+    // Step 5: Print results
+    printLower("\nLower Triangular Matrix (L)", LU, n);
+    printUpper("\nUpper Triangular Matrix (U)", LU, n);
+    printf("\nRow interchanges: ");
+    for (int i = 0; i < n; i++)
+    {
+        printf("%d<->%d ", i, ipiv[i]);
+    }
+    printf("\n");
+
+    // Step 6: Free memory
+    freeMatrix(A, n);
+    freeMatrix(LU, n);
+    free(ipiv);
+
+    return 0;
+}
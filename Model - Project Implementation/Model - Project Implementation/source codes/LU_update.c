@@ -0,0 +1,727 @@
+/*
+Group 03
+
+Hani Abdallah - 21400302
+Houssam Eddine Jamil Nasser - 21400407
+Tan Viet Nguyen - 21400381
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// Relative backward error of the probe solve above which the updated factors (or inverse) are rebuilt from scratch
+#define DRIFT_TOLERANCE 1e-10
+
+enum ERROR_CODES
+{
+    OK,
+    INCORRECT_MATRIX,
+    CALCULATION_ERROR
+};
+
+// LU factors that can follow a changing matrix: P * A = L * U
+// L (unit diagonal, not stored) and U share the LU matrix, perm[i] is the row of A that ended up in row i
+// The current A is kept to measure the drift of the updated factors and to refactorize when it grows
+typedef struct lu_updatable_struct
+{
+    double **A;
+    double **LU;
+    int *perm;
+    int n;
+    int updates;
+    int refactorizations;
+} lu_updatable_t;
+
+// Function to allocate memory for a matrix
+double **allocateMatrix(int rows, int columns)
+{
+    double **matrix = malloc(rows * sizeof(double *));
+    for (int i = 0; i < rows; i++)
+    {
+        matrix[i] = malloc(columns * sizeof(double));
+    }
+    return matrix;
+}
+
+// Free allocated matrix memory
+void freeMatrix(double **matrix, int rows)
+{
+    for (int i = 0; i < rows; i++)
+    {
+        free(matrix[i]);
+    }
+    free(matrix);
+}
+
+// Copy Matrix A to Matrix B
+void copyMatrix(double **original_matrix, double **copied_matrix, int rows, int columns)
+{
+    for (int i = 0; i < rows; i++)
+    {
+        memcpy(copied_matrix[i], original_matrix[i], columns * sizeof(double));
+    }
+}
+
+// Function to print a matrix
+void printMatrix(const char *name, double **matrix, int rows, int columns)
+{
+    printf("%s:\n", name);
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < columns; j++)
+        {
+            printf("%10.4f ", matrix[i][j]);
+        }
+        printf("\n");
+    }
+}
+
+// LU factorization with partial pivoting of the stored A into the stored LU, O(n^3)
+int LU_Refactorize(lu_updatable_t *factorization)
+{
+    int n = factorization->n;
+    double **LU = factorization->LU;
+    int *perm = factorization->perm;
+    copyMatrix(factorization->A, LU, n, n);
+    for (int i = 0; i < n; i++)
+    {
+        perm[i] = i;
+    }
+
+    for (int k = 0; k < n; k++)
+    {
+        int pivot = k;
+        for (int i = k + 1; i < n; i++)
+        {
+            if (fabs(LU[i][k]) > fabs(LU[pivot][k]))
+            {
+                pivot = i;
+            }
+        }
+        if (LU[pivot][k] == 0.0)
+        {
+            return CALCULATION_ERROR;
+        }
+        if (pivot != k)
+        {
+            double *row = LU[k];
+            LU[k] = LU[pivot];
+            LU[pivot] = row;
+            int index = perm[k];
+            perm[k] = perm[pivot];
+            perm[pivot] = index;
+        }
+
+        for (int i = k + 1; i < n; i++)
+        {
+            double factor = LU[i][k] / LU[k][k];
+            LU[i][k] = factor;
+            for (int j = k + 1; j < n; j++)
+            {
+                LU[i][j] -= factor * LU[k][j];
+            }
+        }
+    }
+
+    factorization->updates = 0;
+    factorization->refactorizations++;
+    return OK;
+}
+
+// Take a copy of A and factorize it
+int LU_UpdatableFactorize(double **A, int n, lu_updatable_t *factorization)
+{
+    if (A == NULL || factorization == NULL || n < 1)
+    {
+        return INCORRECT_MATRIX;
+    }
+    factorization->n = n;
+    factorization->A = allocateMatrix(n, n);
+    factorization->LU = allocateMatrix(n, n);
+    factorization->perm = malloc(n * sizeof(int));
+    factorization->refactorizations = -1;
+    copyMatrix(A, factorization->A, n, n);
+    return LU_Refactorize(factorization);
+}
+
+void LU_FreeUpdatable(lu_updatable_t *factorization)
+{
+    freeMatrix(factorization->A, factorization->n);
+    freeMatrix(factorization->LU, factorization->n);
+    free(factorization->perm);
+}
+
+// Solve A x = b with the current factors
+void LU_SolveUpdatable(lu_updatable_t *factorization, double *b, double *x)
+{
+    int n = factorization->n;
+    double **LU = factorization->LU;
+
+    // L y = P b
+    for (int i = 0; i < n; i++)
+    {
+        double sum = b[factorization->perm[i]];
+        for (int j = 0; j < i; j++)
+        {
+            sum -= LU[i][j] * x[j];
+        }
+        x[i] = sum;
+    }
+
+    // U x = y
+    for (int i = n - 1; i >= 0; i--)
+    {
+        double sum = x[i];
+        for (int j = i + 1; j < n; j++)
+        {
+            sum -= LU[i][j] * x[j];
+        }
+        x[i] = sum / LU[i][i];
+    }
+}
+
+// Infinity norm of a matrix (maximum absolute row sum)
+double matrixNorm(double **A, int n)
+{
+    double norm = 0.0;
+    for (int i = 0; i < n; i++)
+    {
+        double sum = 0.0;
+        for (int j = 0; j < n; j++)
+        {
+            sum += fabs(A[i][j]);
+        }
+        if (sum > norm)
+        {
+            norm = sum;
+        }
+    }
+    return norm;
+}
+
+// Infinity norm of a vector
+double vectorNorm(double *x, int n)
+{
+    double norm = 0.0;
+    for (int i = 0; i < n; i++)
+    {
+        if (fabs(x[i]) > norm)
+        {
+            norm = fabs(x[i]);
+        }
+    }
+    return norm;
+}
+
+// Fixed probe vector with entries of both signs and different sizes, so no cancellation hides the error
+void probeVector(double *z, int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        z[i] = ((i % 2) ? -1.0 : 1.0) * (1.0 + (double)i / n);
+    }
+}
+
+// Drift check of the factors: relative backward error ||A x - b|| / (||A|| ||x|| + ||b||)
+// of the solve of A x = b with b = A z for the probe vector z, O(n^2)
+double LU_Drift(lu_updatable_t *factorization)
+{
+    int n = factorization->n;
+    double **A = factorization->A;
+    double *z = malloc(n * sizeof(double));
+    double *b = malloc(n * sizeof(double));
+    double *x = malloc(n * sizeof(double));
+    probeVector(z, n);
+
+    for (int i = 0; i < n; i++)
+    {
+        b[i] = 0.0;
+        for (int j = 0; j < n; j++)
+        {
+            b[i] += A[i][j] * z[j];
+        }
+    }
+    LU_SolveUpdatable(factorization, b, x);
+
+    double residual = 0.0;
+    for (int i = 0; i < n; i++)
+    {
+        double sum = b[i];
+        for (int j = 0; j < n; j++)
+        {
+            sum -= A[i][j] * x[j];
+        }
+        if (fabs(sum) > residual)
+        {
+            residual = fabs(sum);
+        }
+    }
+    double drift = residual / (matrixNorm(A, n) * vectorNorm(x, n) + vectorNorm(b, n));
+    if (isnan(drift))
+    {
+        drift = INFINITY;
+    }
+
+    free(z);
+    free(b);
+    free(x);
+    return drift;
+}
+
+// Bennett's algorithm: L * U + x * y^T = L' * U' in O(n^2), without new pivoting (x and y are overwritten)
+// Fails on a zero pivot, the caller then refactorizes with pivoting
+int bennettUpdate(double **LU, int n, double *x, double *y)
+{
+    for (int k = 0; k < n; k++)
+    {
+        LU[k][k] += x[k] * y[k];
+        if (LU[k][k] == 0.0)
+        {
+            return CALCULATION_ERROR;
+        }
+        y[k] /= LU[k][k];
+        for (int i = k + 1; i < n; i++)
+        {
+            x[i] -= x[k] * LU[i][k];
+            LU[i][k] += y[k] * x[i];
+        }
+        for (int j = k + 1; j < n; j++)
+        {
+            LU[k][j] += x[k] * y[j];
+            y[j] -= y[k] * LU[k][j];
+        }
+    }
+    return OK;
+}
+
+// Rank-1 update A + x * y^T of the stored matrix and its factors, O(n^2)
+// The factors are rebuilt from A when the update breaks down or the drift check fails
+int LU_RankOneUpdate(lu_updatable_t *factorization, double *x, double *y)
+{
+    int n = factorization->n;
+    double *px = malloc(n * sizeof(double));
+    double *py = malloc(n * sizeof(double));
+
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            factorization->A[i][j] += x[i] * y[j];
+        }
+    }
+
+    // P * (A + x * y^T) = L * U + (P * x) * y^T
+    for (int i = 0; i < n; i++)
+    {
+        px[i] = x[factorization->perm[i]];
+        py[i] = y[i];
+    }
+    int status = bennettUpdate(factorization->LU, n, px, py);
+    factorization->updates++;
+
+    if (status != OK || !(LU_Drift(factorization) <= DRIFT_TOLERANCE))
+    {
+        status = LU_Refactorize(factorization);
+    }
+
+    free(px);
+    free(py);
+    return status;
+}
+
+// Replace row r of A by new_row: A + e_r * (new_row - A[r])^T
+int LU_ReplaceRow(lu_updatable_t *factorization, int r, double *new_row)
+{
+    int n = factorization->n;
+    double *x = calloc(n, sizeof(double));
+    double *y = malloc(n * sizeof(double));
+    x[r] = 1.0;
+    for (int j = 0; j < n; j++)
+    {
+        y[j] = new_row[j] - factorization->A[r][j];
+    }
+    int status = LU_RankOneUpdate(factorization, x, y);
+    free(x);
+    free(y);
+    return status;
+}
+
+// Replace column c of A by new_column: A + (new_column - A[:, c]) * e_c^T
+int LU_ReplaceColumn(lu_updatable_t *factorization, int c, double *new_column)
+{
+    int n = factorization->n;
+    double *x = malloc(n * sizeof(double));
+    double *y = calloc(n, sizeof(double));
+    y[c] = 1.0;
+    for (int i = 0; i < n; i++)
+    {
+        x[i] = new_column[i] - factorization->A[i][c];
+    }
+    int status = LU_RankOneUpdate(factorization, x, y);
+    free(x);
+    free(y);
+    return status;
+}
+
+// Solve C * X = W by Gaussian elimination with partial pivoting, X overwrites W (C is k x k, W is k x columns)
+// C is destroyed, used for the small capacitance matrix of the Woodbury formula
+int solveSmallSystem(double **C, int k, double **W, int columns)
+{
+    for (int p = 0; p < k; p++)
+    {
+        int pivot = p;
+        for (int i = p + 1; i < k; i++)
+        {
+            if (fabs(C[i][p]) > fabs(C[pivot][p]))
+            {
+                pivot = i;
+            }
+        }
+        if (C[pivot][p] == 0.0)
+        {
+            return CALCULATION_ERROR;
+        }
+        double *row = C[p];
+        C[p] = C[pivot];
+        C[pivot] = row;
+        row = W[p];
+        W[p] = W[pivot];
+        W[pivot] = row;
+
+        for (int i = p + 1; i < k; i++)
+        {
+            double factor = C[i][p] / C[p][p];
+            for (int j = p + 1; j < k; j++)
+            {
+                C[i][j] -= factor * C[p][j];
+            }
+            for (int j = 0; j < columns; j++)
+            {
+                W[i][j] -= factor * W[p][j];
+            }
+        }
+    }
+    for (int i = k - 1; i >= 0; i--)
+    {
+        for (int p = i + 1; p < k; p++)
+        {
+            for (int j = 0; j < columns; j++)
+            {
+                W[i][j] -= C[i][p] * W[p][j];
+            }
+        }
+        for (int j = 0; j < columns; j++)
+        {
+            W[i][j] /= C[i][i];
+        }
+    }
+    return OK;
+}
+
+// Sherman-Morrison-Woodbury: (A + U * Vt)^-1 = A^-1 - A^-1 * U * (I + Vt * A^-1 * U)^-1 * Vt * A^-1
+// U is n x k and Vt is k x n, A_inv is overwritten in O(n^2 * k)
+int updateInverseWoodbury(double **A_inv, int n, double **U, double **Vt, int k)
+{
+    if (A_inv == NULL || U == NULL || Vt == NULL || n < 1 || k < 1)
+    {
+        return INCORRECT_MATRIX;
+    }
+
+    // Step 1: A^-1 * U (n x k) and Vt * A^-1 (k x n)
+    double **AU = allocateMatrix(n, k);
+    double **VA = allocateMatrix(k, n);
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < k; j++)
+        {
+            AU[i][j] = 0.0;
+        }
+        for (int p = 0; p < n; p++)
+        {
+            double factor = A_inv[i][p];
+            for (int j = 0; j < k; j++)
+            {
+                AU[i][j] += factor * U[p][j];
+            }
+        }
+    }
+    for (int i = 0; i < k; i++)
+    {
+        memset(VA[i], 0, n * sizeof(double));
+        for (int p = 0; p < n; p++)
+        {
+            double factor = Vt[i][p];
+            for (int j = 0; j < n; j++)
+            {
+                VA[i][j] += factor * A_inv[p][j];
+            }
+        }
+    }
+
+    // Step 2: capacitance matrix C = I + Vt * A^-1 * U (k x k), then W = C^-1 * Vt * A^-1
+    double **C = allocateMatrix(k, k);
+    for (int i = 0; i < k; i++)
+    {
+        for (int j = 0; j < k; j++)
+        {
+            C[i][j] = (i == j) ? 1.0 : 0.0;
+            for (int p = 0; p < n; p++)
+            {
+                C[i][j] += Vt[i][p] * AU[p][j];
+            }
+        }
+    }
+    int status = solveSmallSystem(C, k, VA, n);
+
+    // Step 3: A^-1 -= (A^-1 * U) * W
+    if (status == OK)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            for (int p = 0; p < k; p++)
+            {
+                double factor = AU[i][p];
+                for (int j = 0; j < n; j++)
+                {
+                    A_inv[i][j] -= factor * VA[p][j];
+                }
+            }
+        }
+    }
+
+    freeMatrix(AU, n);
+    freeMatrix(VA, k);
+    freeMatrix(C, k);
+    return status;
+}
+
+// Inverse from scratch: LU with partial pivoting, then one solve per column of the identity, O(n^3)
+int invertMatrix(double **A, double **A_inv, int n)
+{
+    lu_updatable_t factorization;
+    int status = LU_UpdatableFactorize(A, n, &factorization);
+    if (status == OK)
+    {
+        double *e = calloc(n, sizeof(double));
+        double *x = malloc(n * sizeof(double));
+        for (int j = 0; j < n; j++)
+        {
+            e[j] = 1.0;
+            LU_SolveUpdatable(&factorization, e, x);
+            e[j] = 0.0;
+            for (int i = 0; i < n; i++)
+            {
+                A_inv[i][j] = x[i];
+            }
+        }
+        free(e);
+        free(x);
+    }
+    LU_FreeUpdatable(&factorization);
+    return status;
+}
+
+// Drift check of an inverse: ||A * (A^-1 * z) - z|| / (||A|| * ||A^-1 * z||) for the probe vector z, O(n^2)
+double inverseDrift(double **A, double **A_inv, int n)
+{
+    double *z = malloc(n * sizeof(double));
+    double *x = malloc(n * sizeof(double));
+    probeVector(z, n);
+
+    for (int i = 0; i < n; i++)
+    {
+        x[i] = 0.0;
+        for (int j = 0; j < n; j++)
+        {
+            x[i] += A_inv[i][j] * z[j];
+        }
+    }
+    double residual = 0.0;
+    for (int i = 0; i < n; i++)
+    {
+        double sum = -z[i];
+        for (int j = 0; j < n; j++)
+        {
+            sum += A[i][j] * x[j];
+        }
+        if (fabs(sum) > residual)
+        {
+            residual = fabs(sum);
+        }
+    }
+    double drift = residual / (matrixNorm(A, n) * vectorNorm(x, n));
+    if (isnan(drift))
+    {
+        drift = INFINITY;
+    }
+
+    free(z);
+    free(x);
+    return drift;
+}
+
+// Replace k rows of A (rows[t] becomes new_rows[t]) and update A_inv with the Woodbury formula, O(n^2 * k)
+// A_inv is recomputed from A when the update fails or the drift check fails; *refactorized reports it
+int replaceRowsInverse(double **A, double **A_inv, int n, int *rows, double **new_rows, int k, int *refactorized)
+{
+    // A' = A + U * Vt with U = [e_rows[0] ... e_rows[k-1]] and Vt[t] = new_rows[t] - A[rows[t]]
+    double **U = allocateMatrix(n, k);
+    double **Vt = allocateMatrix(k, n);
+    for (int i = 0; i < n; i++)
+    {
+        memset(U[i], 0, k * sizeof(double));
+    }
+    for (int t = 0; t < k; t++)
+    {
+        U[rows[t]][t] = 1.0;
+        for (int j = 0; j < n; j++)
+        {
+            Vt[t][j] = new_rows[t][j] - A[rows[t]][j];
+        }
+        memcpy(A[rows[t]], new_rows[t], n * sizeof(double));
+    }
+
+    int status = updateInverseWoodbury(A_inv, n, U, Vt, k);
+    *refactorized = 0;
+    if (status != OK || !(inverseDrift(A, A_inv, n) <= DRIFT_TOLERANCE))
+    {
+        *refactorized = 1;
+        status = invertMatrix(A, A_inv, n);
+    }
+
+    freeMatrix(U, n);
+    freeMatrix(Vt, k);
+    return status;
+}
+
+// Function that request user to input Matrix elements
+void RequestInput(const char *name, double **matrix, int rows, int columns)
+{
+    printf("Input Matrix %s Elements:\n", name);
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < columns; j++)
+        {
+            printf("%s[%d][%d]=", name, i, j);
+            scanf("%lf", &matrix[i][j]);
+        }
+    }
+}
+
+int main()
+{
+    clock_t start_time, end_time;
+    int n, k;
+
+    // Step 1: Get dimensions for Matrix A and the number of rows to replace
+    printf("\nChoose Matrix Dimension for the square matrix: ");
+    scanf("%d", &n);
+    printf("\nChoose the number of rows to replace: ");
+    scanf("%d", &k);
+
+    // Error condition 1
+    if (n <= 0 || k <= 0)
+    {
+        printf("Matrix Size and number of rows can only be larger than zero, the program will exit...");
+        exit(1);
+    }
+
+    // Error condition 2
+    if (k > n)
+    {
+        printf("Cannot replace more rows than the matrix has, the program will exit...");
+        exit(1);
+    }
+
+    // Step 2: Allocate matrices memory
+    double **A = allocateMatrix(n, n);
+    double **A_inv = allocateMatrix(n, n);
+    double **new_rows = allocateMatrix(k, n);
+    int *rows = malloc(k * sizeof(int));
+
+    // Note: You can either enter the matrix input manually, or choose to fill the matrices automatically. But make sure to comment "RequestInput" function calls, and to uncomment the alternative random input option.
+    // Step 3: Asking the user to input Matrix A, the indices of the rows to replace and their new values
+    RequestInput("A", A, n, n);
+    printf("Input the indices of the rows to replace:\n");
+    for (int t = 0; t < k; t++)
+    {
+        printf("row %d=", t);
+        scanf("%d", &rows[t]);
+    }
+    RequestInput("New rows", new_rows, k, n);
+
+    // This is an alternative random input option, but make sure to comment "RequestInput" function calls.
+    /*for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            A[i][j] = (i == j) ? n : ((double)rand() / RAND_MAX);
+        }
+    }
+    for (int t = 0; t < k; t++)
+    {
+        rows[t] = t;
+        for (int j = 0; j < n; j++)
+        {
+            new_rows[t][j] = (t == j) ? n : ((double)rand() / RAND_MAX);
+        }
+    }*/
+
+    // Error condition 3
+    for (int t = 0; t < k; t++)
+    {
+        if (rows[t] < 0 || rows[t] >= n)
+        {
+            printf("Row index out of range, the program will exit...");
+            exit(1);
+        }
+    }
+
+    // Step 4: Initial factorization and inverse, O(n^3)
+    lu_updatable_t factorization;
+    if (LU_UpdatableFactorize(A, n, &factorization) != OK || invertMatrix(A, A_inv, n) != OK)
+    {
+        printf("Matrix is singular, the program will exit...");
+        exit(1);
+    }
+
+    // Step 5: Replace the rows, updating the factors and the inverse in O(n^2 * k)
+    start_time = clock();
+    int status = OK;
+    for (int t = 0; t < k && status == OK; t++)
+    {
+        status = LU_ReplaceRow(&factorization, rows[t], new_rows[t]);
+    }
+    int refactorized;
+    if (status == OK)
+    {
+        status = replaceRowsInverse(A, A_inv, n, rows, new_rows, k, &refactorized);
+    }
+    end_time = clock();
+
+    if (status != OK)
+    {
+        printf("Updated matrix is singular, the program will exit...");
+        exit(1);
+    }
+
+    // Step 6: Print results
+    printMatrix("Updated Matrix A", A, n, n);
+    printMatrix("Updated Inverse", A_inv, n, n);
+    printf("Drift of the updated factors: %.3e, of the updated inverse: %.3e\n", LU_Drift(&factorization), inverseDrift(A, A_inv, n));
+    printf("LU refactorizations triggered: %d, inverse recomputed: %s\n", factorization.refactorizations, refactorized ? "yes" : "no");
+    printf("Time taken for the updates: %.6f seconds\n", (double)(end_time - start_time) / CLOCKS_PER_SEC);
+
+    // Step 7: Free memory
+    LU_FreeUpdatable(&factorization);
+    freeMatrix(A, n);
+    freeMatrix(A_inv, n);
+    freeMatrix(new_rows, k);
+    free(rows);
+
+    return 0;
+}
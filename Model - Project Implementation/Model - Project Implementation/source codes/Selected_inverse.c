@@ -0,0 +1,445 @@
+/*
+Group 03
+
+Hani Abdallah - 21400302
+Houssam Eddine Jamil Nasser - 21400407
+Tan Viet Nguyen - 21400381
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+enum ERROR_CODES
+{
+    OK,
+    INCORRECT_MATRIX,
+    CALCULATION_ERROR
+};
+
+enum SELECTION_MODES
+{
+    SELECT_DIAGONAL,
+    SELECT_COLUMNS,
+    SELECT_BLOCK
+};
+
+// LU factorization handle: P * A = L * U
+// L (unit diagonal, not stored) and U share the LU matrix, perm[i] is the row of A that ended up in row i
+typedef struct lu_factorization_struct
+{
+    double **LU;
+    int *perm;
+    int n;
+} lu_factorization_t;
+
+// One requested block of A^-1: rows row_start .. row_start + rows - 1, columns column_start .. column_start + columns - 1
+// values is rows x columns and is allocated by selectedInverseBlocks, free it with freeMatrix
+typedef struct inverse_block_struct
+{
+    int row_start;
+    int column_start;
+    int rows;
+    int columns;
+    double **values;
+} inverse_block_t;
+
+// Function to allocate memory for a matrix
+double **allocateMatrix(int rows, int columns)
+{
+    double **matrix = malloc(rows * sizeof(double *));
+    for (int i = 0; i < rows; i++)
+    {
+        matrix[i] = malloc(columns * sizeof(double));
+    }
+    return matrix;
+}
+
+// Free allocated matrix memory
+void freeMatrix(double **matrix, int rows)
+{
+    for (int i = 0; i < rows; i++)
+    {
+        free(matrix[i]);
+    }
+    free(matrix);
+}
+
+// Copy Matrix A to Matrix B
+void copyMatrix(double **original_matrix, double **copied_matrix, int rows, int columns)
+{
+    for (int i = 0; i < rows; i++)
+    {
+        memcpy(copied_matrix[i], original_matrix[i], columns * sizeof(double));
+    }
+}
+
+// Function to print a matrix
+void printMatrix(const char *name, double **matrix, int rows, int columns)
+{
+    printf("%s:\n", name);
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < columns; j++)
+        {
+            printf("%10.4f ", matrix[i][j]);
+        }
+        printf("\n");
+    }
+}
+
+void LU_FreeFactorization(lu_factorization_t *factorization)
+{
+    if (factorization != NULL && factorization->LU != NULL)
+    {
+        freeMatrix(factorization->LU, factorization->n);
+        free(factorization->perm);
+        factorization->LU = NULL;
+        factorization->perm = NULL;
+    }
+}
+
+// LU factorization with partial pivoting, A is left untouched and the factors are freed again when A is singular
+// Row swaps only exchange row pointers, so they cost O(1) each
+int LU_Factorize(double **A, int n, lu_factorization_t *factorization)
+{
+    if (A == NULL || factorization == NULL || n < 1)
+    {
+        return INCORRECT_MATRIX;
+    }
+
+    double **LU = allocateMatrix(n, n);
+    int *perm = malloc(n * sizeof(int));
+    copyMatrix(A, LU, n, n);
+    for (int i = 0; i < n; i++)
+    {
+        perm[i] = i;
+    }
+
+    int status = OK;
+    for (int k = 0; k < n && status == OK; k++)
+    {
+        // Pivot: largest entry of column k on or below the diagonal
+        int pivot = k;
+        for (int i = k + 1; i < n; i++)
+        {
+            if (fabs(LU[i][k]) > fabs(LU[pivot][k]))
+            {
+                pivot = i;
+            }
+        }
+        if (LU[pivot][k] == 0.0)
+        {
+            status = CALCULATION_ERROR;
+            break;
+        }
+        if (pivot != k)
+        {
+            double *row = LU[k];
+            LU[k] = LU[pivot];
+            LU[pivot] = row;
+            int index = perm[k];
+            perm[k] = perm[pivot];
+            perm[pivot] = index;
+        }
+
+        for (int i = k + 1; i < n; i++)
+        {
+            double factor = LU[i][k] / LU[k][k];
+            LU[i][k] = factor;
+            for (int j = k + 1; j < n; j++)
+            {
+                LU[i][j] -= factor * LU[k][j];
+            }
+        }
+    }
+
+    factorization->LU = LU;
+    factorization->perm = perm;
+    factorization->n = n;
+    if (status != OK)
+    {
+        LU_FreeFactorization(factorization);
+    }
+    return status;
+}
+
+// Rows first_row .. n-1 of column j of A^-1, into x[first_row .. n-1]
+// P * e_j has its only nonzero in row position[j], so forward substitution starts there,
+// and back substitution stops at first_row since U is upper triangular
+// position is the inverse of perm, x needs n entries of room
+void solveInverseColumn(lu_factorization_t *factorization, int *position, int j, int first_row, double *x)
+{
+    int n = factorization->n;
+    double **LU = factorization->LU;
+    int start = position[j];
+
+    // Forward substitution: L y = P e_j, y is zero above start
+    for (int i = 0; i < start; i++)
+    {
+        x[i] = 0.0;
+    }
+    x[start] = 1.0;
+    for (int i = start + 1; i < n; i++)
+    {
+        double sum = 0.0;
+        for (int k = start; k < i; k++)
+        {
+            sum -= LU[i][k] * x[k];
+        }
+        x[i] = sum;
+    }
+
+    // Backward substitution: U x = y, only down to first_row
+    for (int i = n - 1; i >= first_row; i--)
+    {
+        double sum = x[i];
+        for (int k = i + 1; k < n; k++)
+        {
+            sum -= LU[i][k] * x[k];
+        }
+        x[i] = sum / LU[i][i];
+    }
+}
+
+// Inverse of the row permutation: position[perm[i]] = i
+int *inversePermutation(lu_factorization_t *factorization)
+{
+    int *position = malloc(factorization->n * sizeof(int));
+    for (int i = 0; i < factorization->n; i++)
+    {
+        position[factorization->perm[i]] = i;
+    }
+    return position;
+}
+
+// The requested columns of A^-1, X is n x count with X[i][c] = (A^-1)[i][columns[c]]
+// Cost is O(n^2) per column and O(n * count) memory, nothing n x n is formed beyond the factors
+int selectedInverseColumns(lu_factorization_t *factorization, int *columns, int count, double **X)
+{
+    int n = factorization->n;
+    for (int c = 0; c < count; c++)
+    {
+        if (columns[c] < 0 || columns[c] >= n)
+        {
+            return INCORRECT_MATRIX;
+        }
+    }
+
+    int *position = inversePermutation(factorization);
+    double *x = malloc(n * sizeof(double));
+    for (int c = 0; c < count; c++)
+    {
+        solveInverseColumn(factorization, position, columns[c], 0, x);
+        for (int i = 0; i < n; i++)
+        {
+            X[i][c] = x[i];
+        }
+    }
+    free(x);
+    free(position);
+    return OK;
+}
+
+// The requested blocks of A^-1, each block only pays for its own columns and the rows from its first row down
+int selectedInverseBlocks(lu_factorization_t *factorization, inverse_block_t *blocks, int count)
+{
+    int n = factorization->n;
+    for (int b = 0; b < count; b++)
+    {
+        inverse_block_t *block = &blocks[b];
+        if (block->rows < 1 || block->columns < 1 || block->row_start < 0 || block->column_start < 0 ||
+            block->row_start + block->rows > n || block->column_start + block->columns > n)
+        {
+            return INCORRECT_MATRIX;
+        }
+    }
+
+    int *position = inversePermutation(factorization);
+    double *x = malloc(n * sizeof(double));
+    for (int b = 0; b < count; b++)
+    {
+        inverse_block_t *block = &blocks[b];
+        block->values = allocateMatrix(block->rows, block->columns);
+        for (int j = 0; j < block->columns; j++)
+        {
+            solveInverseColumn(factorization, position, block->column_start + j, block->row_start, x);
+            for (int i = 0; i < block->rows; i++)
+            {
+                block->values[i][j] = x[block->row_start + i];
+            }
+        }
+    }
+    free(x);
+    free(position);
+    return OK;
+}
+
+// diag(A^-1): column j is only needed from row j down, O(n) memory beyond the factors
+int selectedInverseDiagonal(lu_factorization_t *factorization, double *diagonal)
+{
+    int n = factorization->n;
+    int *position = inversePermutation(factorization);
+    double *x = malloc(n * sizeof(double));
+    for (int j = 0; j < n; j++)
+    {
+        solveInverseColumn(factorization, position, j, j, x);
+        diagonal[j] = x[j];
+    }
+    free(x);
+    free(position);
+    return OK;
+}
+
+// Function that request user to input Matrix elements
+void RequestInput(const char *name, double **matrix, int rows, int columns)
+{
+    printf("Input Matrix %s Elements:\n", name);
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < columns; j++)
+        {
+            printf("%s[%d][%d]=", name, i, j);
+            scanf("%lf", &matrix[i][j]);
+        }
+    }
+}
+
+int main()
+{
+    clock_t start_time, end_time;
+    int n, mode;
+    int count = 0;
+    int *columns = NULL;
+    inverse_block_t block = {0, 0, 0, 0, NULL};
+
+    // Step 1: Get dimensions for Matrix A and the part of the inverse that is needed
+    printf("\nChoose Matrix Dimension for the square matrix: ");
+    scanf("%d", &n);
+
+    // Error condition 1
+    if (n <= 0)
+    {
+        printf("Matrix Size can only be larger than zero, the program will exit...");
+        exit(1);
+    }
+
+    printf("\nChoose the selection (0: diagonal only, 1: columns, 2: one block): ");
+    scanf("%d", &mode);
+    if (mode == SELECT_COLUMNS)
+    {
+        printf("\nChoose the number of columns: ");
+        scanf("%d", &count);
+        if (count > 0)
+        {
+            columns = malloc(count * sizeof(int));
+            for (int c = 0; c < count; c++)
+            {
+                printf("column[%d]=", c);
+                scanf("%d", &columns[c]);
+            }
+        }
+    }
+    else if (mode == SELECT_BLOCK)
+    {
+        printf("\nChoose the first row, first column, rows and columns of the block: ");
+        scanf("%d %d %d %d", &block.row_start, &block.column_start, &block.rows, &block.columns);
+    }
+
+    // Error condition 2
+    if ((mode != SELECT_DIAGONAL && mode != SELECT_COLUMNS && mode != SELECT_BLOCK) || (mode == SELECT_COLUMNS && count <= 0))
+    {
+        printf("Selection is not valid, the program will exit...");
+        exit(1);
+    }
+
+    // Step 2: Allocate matrix memory
+    double **A = allocateMatrix(n, n);
+
+    // Note: You can either enter the matrix input manually, or choose to fill the matrices automatically. But make sure to comment "RequestInput" function calls, and to uncomment the alternative random input option.
+    // Step 3: Asking the user to input Matrix A elements
+    RequestInput("A", A, n, n);
+
+    // This is an alternative random input option, but make sure to comment "RequestInput" function calls.
+    /*for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            A[i][j] = (i == j) ? 1.0 : ((double)rand() / RAND_MAX);
+        }
+    }*/
+
+    // Step 4: Factorize A once
+    lu_factorization_t factorization;
+    start_time = clock();
+    int status = LU_Factorize(A, n, &factorization);
+    end_time = clock();
+
+    // Error condition 3
+    if (status != OK)
+    {
+        printf("Matrix is singular, the program will exit...");
+        exit(1);
+    }
+    printf("Time taken for LU Factorization: %.6f seconds\n", (double)(end_time - start_time) / CLOCKS_PER_SEC);
+
+    // Step 5: Compute only the requested part of A^-1 and print it
+    if (mode == SELECT_DIAGONAL)
+    {
+        double *diagonal = malloc(n * sizeof(double));
+        start_time = clock();
+        status = selectedInverseDiagonal(&factorization, diagonal);
+        end_time = clock();
+
+        printf("Diagonal of A inverse:\n");
+        for (int i = 0; i < n; i++)
+        {
+            printf("%10.4f ", diagonal[i]);
+        }
+        printf("\n");
+        free(diagonal);
+    }
+    else if (mode == SELECT_COLUMNS)
+    {
+        double **X = allocateMatrix(n, count);
+        start_time = clock();
+        status = selectedInverseColumns(&factorization, columns, count, X);
+        end_time = clock();
+
+        if (status == OK)
+        {
+            printMatrix("Selected columns of A inverse", X, n, count);
+        }
+        freeMatrix(X, n);
+    }
+    else
+    {
+        start_time = clock();
+        status = selectedInverseBlocks(&factorization, &block, 1);
+        end_time = clock();
+
+        if (status == OK)
+        {
+            printMatrix("Selected block of A inverse", block.values, block.rows, block.columns);
+            freeMatrix(block.values, block.rows);
+        }
+    }
+
+    // Error condition 4
+    if (status != OK)
+    {
+        printf("Selection is outside the matrix, the program will exit...");
+        exit(1);
+    }
+    printf("Time taken for the selected inversion: %.6f seconds\n", (double)(end_time - start_time) / CLOCKS_PER_SEC);
+
+    // Step 6: Free memory
+    LU_FreeFactorization(&factorization);
+    freeMatrix(A, n);
+    free(columns);
+
+    return 0;
+}
@@ -0,0 +1,1400 @@
+/*
+Group 03
+
+Hani Abdallah - 21400302
+Houssam Eddine Jamil Nasser - 21400407
+Tan Viet Nguyen - 21400381
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <time.h>
+
+// Refinement steps allowed on the sparse solution, and the componentwise backward error it has to reach
+#define REFINEMENT_STEPS 10
+#define BACKWARD_ERROR_LIMIT 1e-12
+// Largest n for the dense pivoted LU fallback: n x n doubles and O(n^3) work, 4000 is already 128 MB
+#define DENSE_FALLBACK_LIMIT 4000
+
+enum ERROR_CODES
+{
+    OK,
+    INCORRECT_MATRIX,
+    CALCULATION_ERROR
+};
+
+enum SOLVE_METHODS
+{
+    SPARSE_LU_SOLVE,
+    DENSE_LU_FALLBACK
+};
+
+// Compressed sparse matrix
+// CSC: ptr has columns + 1 entries and index holds row indices
+// CSR: ptr has rows + 1 entries and index holds column indices (the CSR of A is the CSC of A^T)
+typedef struct sparse_matrix_struct
+{
+    int rows;
+    int columns;
+    int nnz;
+    int *ptr;
+    int *index;
+    double *values;
+} sparse_matrix_t;
+
+// Supernodal LU factors of P * Q * A * P^T, with row interchanges restricted to each supernode
+// Q puts a nonzero on every diagonal entry (row_match[j] is the row of A moved to row j), but it only fixes the
+// structure: a pivot that is still too small is replaced by a static one, perturbed counts those replacements,
+// and the solution is then corrected by iterative refinement against A
+// Supernode s owns the columns first[s] .. first[s + 1] - 1 and the rows structure[s] below them
+// L_blocks[s] is (k + r) x k and U_blocks[s] is k x (k + r), both row-major, with k columns and r structure rows
+typedef struct sparse_lu_struct
+{
+    int n;
+    int *row_match;
+    int *perm;
+    int supernodes;
+    int *first;
+    int *structure_size;
+    int **structure;
+    int **row_order;
+    double **L_blocks;
+    double **U_blocks;
+    int perturbed;
+} sparse_lu_t;
+
+// allocate memory for matrices
+double **allocateMatrix(int rows, int columns)
+{
+    double **matrix = (double **)malloc(rows * sizeof(double *));
+    for (int i = 0; i < rows; i++)
+    {
+        matrix[i] = (double *)calloc(columns, sizeof(double));
+    }
+    return matrix;
+}
+
+// free allocated memory of matrices
+void freeMatrix(double **matrix, int rows)
+{
+    for (int i = 0; i < rows; i++)
+    {
+        free(matrix[i]);
+    }
+    free(matrix);
+}
+
+// Dense kernel used for the Schur complement of every supernode, same kernel as Naive_matrix_multiplication.c
+void Naive_matrix_multiplication(double **A, double **B, double **R, int rows_A, int cols_A, int cols_B)
+{
+    for (int i = 0; i < rows_A; i++)
+    {
+        for (int j = 0; j < cols_B; j++)
+        {
+            R[i][j] = 0.0;
+        }
+        for (int k = 0; k < cols_A; k++)
+        {
+            double factor = A[i][k];
+            for (int j = 0; j < cols_B; j++)
+            {
+                R[i][j] += factor * B[k][j];
+            }
+        }
+    }
+}
+
+int createSparseMatrix(int rows, int columns, int nnz, sparse_matrix_t *result)
+{
+    if (result == NULL || rows < 1 || columns < 1 || nnz < 0)
+    {
+        return INCORRECT_MATRIX;
+    }
+    result->rows = rows;
+    result->columns = columns;
+    result->nnz = nnz;
+    result->ptr = calloc(columns + 1, sizeof(int));
+    result->index = malloc((nnz > 0 ? nnz : 1) * sizeof(int));
+    result->values = malloc((nnz > 0 ? nnz : 1) * sizeof(double));
+    if (result->ptr == NULL || result->index == NULL || result->values == NULL)
+    {
+        return INCORRECT_MATRIX;
+    }
+    return OK;
+}
+
+void freeSparseMatrix(sparse_matrix_t *A)
+{
+    free(A->ptr);
+    free(A->index);
+    free(A->values);
+    A->ptr = NULL;
+    A->index = NULL;
+    A->values = NULL;
+}
+
+// Build a CSC matrix from (row, column, value) triplets, duplicates are kept and summed on use
+int tripletsToCSC(int n, int nnz, int *rows, int *columns, double *values, sparse_matrix_t *result)
+{
+    int status = createSparseMatrix(n, n, nnz, result);
+    if (status != OK)
+    {
+        return status;
+    }
+    for (int t = 0; t < nnz; t++)
+    {
+        if (rows[t] < 0 || rows[t] >= n || columns[t] < 0 || columns[t] >= n)
+        {
+            return INCORRECT_MATRIX;
+        }
+        result->ptr[columns[t] + 1]++;
+    }
+    for (int j = 0; j < n; j++)
+    {
+        result->ptr[j + 1] += result->ptr[j];
+    }
+    int *next = malloc(n * sizeof(int));
+    memcpy(next, result->ptr, n * sizeof(int));
+    for (int t = 0; t < nnz; t++)
+    {
+        int position = next[columns[t]]++;
+        result->index[position] = rows[t];
+        result->values[position] = values[t];
+    }
+    free(next);
+    return OK;
+}
+
+// Transpose, which is also the CSC <-> CSR conversion
+int transposeSparse(sparse_matrix_t *A, sparse_matrix_t *result)
+{
+    int status = createSparseMatrix(A->columns, A->rows, A->nnz, result);
+    if (status != OK)
+    {
+        return status;
+    }
+    for (int p = 0; p < A->nnz; p++)
+    {
+        result->ptr[A->index[p] + 1]++;
+    }
+    for (int i = 0; i < A->rows; i++)
+    {
+        result->ptr[i + 1] += result->ptr[i];
+    }
+    int *next = malloc(A->rows * sizeof(int));
+    memcpy(next, result->ptr, A->rows * sizeof(int));
+    for (int j = 0; j < A->columns; j++)
+    {
+        for (int p = A->ptr[j]; p < A->ptr[j + 1]; p++)
+        {
+            int position = next[A->index[p]]++;
+            result->index[position] = j;
+            result->values[position] = A->values[p];
+        }
+    }
+    free(next);
+    return OK;
+}
+
+// Maximum transversal (Duff's MC21): match every column j with a row row_match[j] holding a nonzero,
+// using depth-first augmenting paths; moving those rows onto the diagonal gives the symmetric ordering
+// and the restricted pivoting nonzero diagonal entries to start from
+// Returns CALCULATION_ERROR when A is structurally singular
+int maximumTransversal(sparse_matrix_t *A, int *row_match)
+{
+    int n = A->columns;
+    int *column_match = malloc(n * sizeof(int));
+    int *cheap = malloc(n * sizeof(int));
+    int *visited = malloc(n * sizeof(int));
+    int *column_stack = malloc(n * sizeof(int));
+    int *row_stack = malloc(n * sizeof(int));
+    int *position_stack = malloc(n * sizeof(int));
+    int status = OK;
+
+    for (int j = 0; j < n; j++)
+    {
+        column_match[j] = -1;
+        row_match[j] = -1;
+        cheap[j] = A->ptr[j];
+        visited[j] = -1;
+    }
+
+    for (int k = 0; k < n; k++)
+    {
+        int found = 0;
+        int head = 0;
+        column_stack[0] = k;
+        while (head >= 0)
+        {
+            int j = column_stack[head];
+            if (visited[j] != k)
+            {
+                // First visit of j: look for a row that is still free
+                visited[j] = k;
+                int p;
+                int i = -1;
+                for (p = cheap[j]; p < A->ptr[j + 1] && !found; p++)
+                {
+                    i = A->index[p];
+                    found = (column_match[i] == -1);
+                }
+                cheap[j] = p;
+                if (found)
+                {
+                    row_stack[head] = i;
+                    break;
+                }
+                position_stack[head] = A->ptr[j];
+            }
+
+            // Otherwise go deeper through a matched row whose column was not visited yet
+            int p;
+            for (p = position_stack[head]; p < A->ptr[j + 1]; p++)
+            {
+                int i = A->index[p];
+                if (visited[column_match[i]] == k)
+                {
+                    continue;
+                }
+                position_stack[head] = p + 1;
+                row_stack[head] = i;
+                column_stack[++head] = column_match[i];
+                break;
+            }
+            if (p == A->ptr[j + 1])
+            {
+                head--;
+            }
+        }
+
+        if (!found)
+        {
+            status = CALCULATION_ERROR;
+            break;
+        }
+        // Flip the matching along the augmenting path
+        for (int p = head; p >= 0; p--)
+        {
+            column_match[row_stack[p]] = column_stack[p];
+            row_match[column_stack[p]] = row_stack[p];
+        }
+    }
+
+    free(column_match);
+    free(cheap);
+    free(visited);
+    free(column_stack);
+    free(row_stack);
+    free(position_stack);
+    return status;
+}
+
+// Adjacency lists of the graph of A + A^T (no self loops, no duplicates), as arrays owned by the caller
+void symmetricPattern(sparse_matrix_t *A, sparse_matrix_t *AT, int **adjacency, int *degree)
+{
+    int n = A->columns;
+    int *mark = malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++)
+    {
+        mark[i] = -1;
+    }
+    for (int j = 0; j < n; j++)
+    {
+        int count = A->ptr[j + 1] - A->ptr[j] + AT->ptr[j + 1] - AT->ptr[j];
+        adjacency[j] = malloc((count > 0 ? count : 1) * sizeof(int));
+        degree[j] = 0;
+        mark[j] = j;
+        for (int p = A->ptr[j]; p < A->ptr[j + 1]; p++)
+        {
+            if (mark[A->index[p]] != j)
+            {
+                mark[A->index[p]] = j;
+                adjacency[j][degree[j]++] = A->index[p];
+            }
+        }
+        for (int p = AT->ptr[j]; p < AT->ptr[j + 1]; p++)
+        {
+            if (mark[AT->index[p]] != j)
+            {
+                mark[AT->index[p]] = j;
+                adjacency[j][degree[j]++] = AT->index[p];
+            }
+        }
+    }
+    free(mark);
+}
+
+// Minimum degree ordering on the elimination graph of A + A^T
+// Nodes wait in degree buckets, eliminating a node turns its neighbours into a clique and updates their degrees
+// perm[k] is the node eliminated at step k; the adjacency lists are consumed
+void minimumDegreeOrdering(int **adjacency, int *degree, int n, int *perm)
+{
+    int *head = malloc(n * sizeof(int));
+    int *next = malloc(n * sizeof(int));
+    int *previous = malloc(n * sizeof(int));
+    int *capacity = malloc(n * sizeof(int));
+    int *mark = malloc(n * sizeof(int));
+    char *eliminated = calloc(n, sizeof(char));
+
+    for (int d = 0; d < n; d++)
+    {
+        head[d] = -1;
+    }
+    for (int v = 0; v < n; v++)
+    {
+        capacity[v] = degree[v] > 0 ? degree[v] : 1;
+        mark[v] = -1;
+        previous[v] = -1;
+        next[v] = head[degree[v]];
+        if (head[degree[v]] != -1)
+        {
+            previous[head[degree[v]]] = v;
+        }
+        head[degree[v]] = v;
+    }
+
+    int min_degree = 0;
+    for (int k = 0; k < n; k++)
+    {
+        while (head[min_degree] == -1)
+        {
+            min_degree++;
+        }
+        int v = head[min_degree];
+        head[min_degree] = next[v];
+        if (next[v] != -1)
+        {
+            previous[next[v]] = -1;
+        }
+        eliminated[v] = 1;
+        perm[k] = v;
+
+        for (int a = 0; a < degree[v]; a++)
+        {
+            int u = adjacency[v][a];
+
+            // Take u out of its bucket
+            if (previous[u] != -1)
+            {
+                next[previous[u]] = next[u];
+            }
+            else
+            {
+                head[degree[u]] = next[u];
+            }
+            if (next[u] != -1)
+            {
+                previous[next[u]] = previous[u];
+            }
+
+            // adj(u) = adj(u) - {v} + adj(v) - {u}
+            int size = 0;
+            mark[u] = u;
+            for (int b = 0; b < degree[u]; b++)
+            {
+                int w = adjacency[u][b];
+                if (w != v && !eliminated[w])
+                {
+                    mark[w] = u;
+                    adjacency[u][size++] = w;
+                }
+            }
+            for (int b = 0; b < degree[v]; b++)
+            {
+                int w = adjacency[v][b];
+                if (mark[w] != u)
+                {
+                    mark[w] = u;
+                    if (size == capacity[u])
+                    {
+                        capacity[u] *= 2;
+                        adjacency[u] = realloc(adjacency[u], capacity[u] * sizeof(int));
+                    }
+                    adjacency[u][size++] = w;
+                }
+            }
+            // Clear the marks for the next neighbour
+            for (int b = 0; b < size; b++)
+            {
+                mark[adjacency[u][b]] = -1;
+            }
+            mark[u] = -1;
+            degree[u] = size;
+
+            // Back into the bucket of its new degree
+            previous[u] = -1;
+            next[u] = head[size];
+            if (head[size] != -1)
+            {
+                previous[head[size]] = u;
+            }
+            head[size] = u;
+            if (size < min_degree)
+            {
+                min_degree = size;
+            }
+        }
+        free(adjacency[v]);
+        adjacency[v] = NULL;
+    }
+
+    free(head);
+    free(next);
+    free(previous);
+    free(capacity);
+    free(mark);
+    free(eliminated);
+}
+
+// Elimination tree of the symmetric pattern (Liu's algorithm with path compression)
+// adjacency is given in the new numbering, parent[j] = -1 for roots
+void eliminationTree(int **adjacency, int *degree, int n, int *parent)
+{
+    int *ancestor = malloc(n * sizeof(int));
+    for (int j = 0; j < n; j++)
+    {
+        parent[j] = -1;
+        ancestor[j] = -1;
+        for (int a = 0; a < degree[j]; a++)
+        {
+            int i = adjacency[j][a];
+            // Walk from i up to the root of its current subtree, pointing the path at j
+            while (i != -1 && i < j)
+            {
+                int next = ancestor[i];
+                ancestor[i] = j;
+                if (next == -1)
+                {
+                    parent[i] = j;
+                }
+                i = next;
+            }
+        }
+    }
+    free(ancestor);
+}
+
+// Depth-first postorder of a forest, post[k] is the k-th node visited
+void treePostorder(int *parent, int n, int *post)
+{
+    int *head = malloc(n * sizeof(int));
+    int *next = malloc(n * sizeof(int));
+    int *stack = malloc(n * sizeof(int));
+    for (int j = 0; j < n; j++)
+    {
+        head[j] = -1;
+    }
+    for (int j = n - 1; j >= 0; j--)
+    {
+        if (parent[j] != -1)
+        {
+            next[j] = head[parent[j]];
+            head[parent[j]] = j;
+        }
+    }
+    int k = 0;
+    for (int root = 0; root < n; root++)
+    {
+        if (parent[root] != -1)
+        {
+            continue;
+        }
+        int top = 0;
+        stack[0] = root;
+        while (top >= 0)
+        {
+            int node = stack[top];
+            int child = head[node];
+            if (child == -1)
+            {
+                top--;
+                post[k++] = node;
+            }
+            else
+            {
+                head[node] = next[child];
+                stack[++top] = child;
+            }
+        }
+    }
+    free(head);
+    free(next);
+    free(stack);
+}
+
+// Relabel the adjacency lists so node perm[k] becomes node k
+void permutePattern(int **adjacency, int *degree, int n, int *perm, int ***new_adjacency, int **new_degree)
+{
+    int *inverse = malloc(n * sizeof(int));
+    for (int k = 0; k < n; k++)
+    {
+        inverse[perm[k]] = k;
+    }
+    *new_adjacency = malloc(n * sizeof(int *));
+    *new_degree = malloc(n * sizeof(int));
+    for (int k = 0; k < n; k++)
+    {
+        int v = perm[k];
+        (*new_degree)[k] = degree[v];
+        (*new_adjacency)[k] = malloc((degree[v] > 0 ? degree[v] : 1) * sizeof(int));
+        for (int a = 0; a < degree[v]; a++)
+        {
+            (*new_adjacency)[k][a] = inverse[adjacency[v][a]];
+        }
+    }
+    free(inverse);
+}
+
+// Symbolic analysis: fill-reducing order, elimination tree, row structure of every column of L
+// and fundamental supernodes (chains of columns sharing the same structure)
+void symbolicAnalysis(sparse_matrix_t *A, sparse_matrix_t *AT, sparse_lu_t *factors, int **supernode_parent)
+{
+    int n = A->columns;
+    int **adjacency = malloc(n * sizeof(int *));
+    int *degree = malloc(n * sizeof(int));
+    int *order = malloc(n * sizeof(int));
+
+    // Step 1: minimum degree order on A + A^T
+    symmetricPattern(A, AT, adjacency, degree);
+    minimumDegreeOrdering(adjacency, degree, n, order);
+    free(adjacency);
+    free(degree);
+
+    // Step 2: elimination tree in that order, then postorder it so that every subtree is contiguous
+    adjacency = malloc(n * sizeof(int *));
+    degree = malloc(n * sizeof(int));
+    symmetricPattern(A, AT, adjacency, degree);
+    int **ordered;
+    int *ordered_degree;
+    permutePattern(adjacency, degree, n, order, &ordered, &ordered_degree);
+    int *parent = malloc(n * sizeof(int));
+    int *post = malloc(n * sizeof(int));
+    eliminationTree(ordered, ordered_degree, n, parent);
+    treePostorder(parent, n, post);
+
+    factors->n = n;
+    factors->perm = malloc(n * sizeof(int));
+    for (int k = 0; k < n; k++)
+    {
+        factors->perm[k] = order[post[k]];
+    }
+    for (int j = 0; j < n; j++)
+    {
+        free(ordered[j]);
+    }
+    free(ordered);
+    free(ordered_degree);
+    permutePattern(adjacency, degree, n, factors->perm, &ordered, &ordered_degree);
+    eliminationTree(ordered, ordered_degree, n, parent);
+    for (int j = 0; j < n; j++)
+    {
+        free(adjacency[j]);
+    }
+    free(adjacency);
+    free(degree);
+
+    // Step 3: struct(L_j) = {i > j in A_j} + struct of the children of j, minus j
+    int **column_structure = malloc(n * sizeof(int *));
+    int *column_count = calloc(n, sizeof(int));
+    int *child_count = calloc(n, sizeof(int));
+    int *mark = malloc(n * sizeof(int));
+    for (int j = 0; j < n; j++)
+    {
+        mark[j] = -1;
+        if (parent[j] != -1)
+        {
+            child_count[parent[j]]++;
+        }
+    }
+    int *buffer = malloc(n * sizeof(int));
+    int **children_structure = calloc(n, sizeof(int *));
+    int *children_size = calloc(n, sizeof(int));
+    for (int j = 0; j < n; j++)
+    {
+        int size = 0;
+        mark[j] = j;
+        for (int a = 0; a < ordered_degree[j]; a++)
+        {
+            int i = ordered[j][a];
+            if (i > j && mark[i] != j)
+            {
+                mark[i] = j;
+                buffer[size++] = i;
+            }
+        }
+        for (int a = 0; a < children_size[j]; a++)
+        {
+            int i = children_structure[j][a];
+            if (mark[i] != j)
+            {
+                mark[i] = j;
+                buffer[size++] = i;
+            }
+        }
+        free(children_structure[j]);
+        column_structure[j] = malloc((size > 0 ? size : 1) * sizeof(int));
+        memcpy(column_structure[j], buffer, size * sizeof(int));
+        column_count[j] = size;
+
+        // Hand the structure (without the parent itself) up to the parent
+        int p = parent[j];
+        if (p != -1)
+        {
+            children_structure[p] = realloc(children_structure[p], (children_size[p] + size) * sizeof(int));
+            for (int a = 0; a < size; a++)
+            {
+                if (column_structure[j][a] != p)
+                {
+                    children_structure[p][children_size[p]++] = column_structure[j][a];
+                }
+            }
+        }
+    }
+    free(buffer);
+    free(children_structure);
+    free(children_size);
+    free(mark);
+    for (int j = 0; j < n; j++)
+    {
+        free(ordered[j]);
+    }
+    free(ordered);
+    free(ordered_degree);
+
+    // Step 4: fundamental supernodes, column j joins column j - 1 when j is its parent,
+    // j - 1 is its only child and their structures match
+    int *supernode_of = malloc(n * sizeof(int));
+    factors->first = malloc((n + 1) * sizeof(int));
+    int supernodes = 0;
+    for (int j = 0; j < n; j++)
+    {
+        if (j > 0 && parent[j - 1] == j && child_count[j] == 1 && column_count[j - 1] == column_count[j] + 1)
+        {
+            supernode_of[j] = supernodes - 1;
+        }
+        else
+        {
+            factors->first[supernodes] = j;
+            supernode_of[j] = supernodes++;
+        }
+    }
+    factors->first[supernodes] = n;
+    factors->supernodes = supernodes;
+    factors->structure = malloc(supernodes * sizeof(int *));
+    factors->structure_size = malloc(supernodes * sizeof(int));
+    *supernode_parent = malloc(supernodes * sizeof(int));
+    for (int s = 0; s < supernodes; s++)
+    {
+        int last = factors->first[s + 1] - 1;
+        factors->structure[s] = column_structure[last];
+        factors->structure_size[s] = column_count[last];
+        (*supernode_parent)[s] = (parent[last] == -1) ? -1 : supernode_of[parent[last]];
+        for (int j = factors->first[s]; j < last; j++)
+        {
+            free(column_structure[j]);
+        }
+    }
+
+    free(column_structure);
+    free(column_count);
+    free(child_count);
+    free(supernode_of);
+    free(parent);
+    free(post);
+    free(order);
+}
+
+// Numeric multifrontal factorization, supernodes are visited in postorder (children first)
+// Every front is a dense matrix: original entries and the children's Schur complements are assembled,
+// the k pivot columns are factorized with pivoting restricted to the k pivot rows, and the Schur complement
+// of the remaining rows is formed with the dense multiplication kernel and handed to the parent
+// Since the pivot rows cannot leave the supernode, a pivot below sqrt(eps) * max|a_ij| is replaced by that value
+// with its sign (static pivoting), the error this makes is left to the refinement in SparseLU_SolveRefined
+int numericFactorization(sparse_matrix_t *A, sparse_matrix_t *AT, sparse_lu_t *factors, int *supernode_parent)
+{
+    int n = factors->n;
+    int supernodes = factors->supernodes;
+    int status = OK;
+
+    double largest = 0.0;
+    for (int p = 0; p < A->nnz; p++)
+    {
+        if (fabs(A->values[p]) > largest)
+        {
+            largest = fabs(A->values[p]);
+        }
+    }
+    double static_pivot = sqrt(DBL_EPSILON) * largest;
+    factors->perturbed = 0;
+
+    int *inverse = malloc(n * sizeof(int));
+    int *position = malloc(n * sizeof(int));
+    for (int k = 0; k < n; k++)
+    {
+        inverse[factors->perm[k]] = k;
+    }
+
+    // Children of every supernode, and the contribution blocks waiting for their parent
+    int *child_head = malloc(supernodes * sizeof(int));
+    int *child_next = malloc(supernodes * sizeof(int));
+    double ***contribution = calloc(supernodes, sizeof(double **));
+    for (int s = 0; s < supernodes; s++)
+    {
+        child_head[s] = -1;
+    }
+    for (int s = supernodes - 1; s >= 0; s--)
+    {
+        if (supernode_parent[s] != -1)
+        {
+            child_next[s] = child_head[supernode_parent[s]];
+            child_head[supernode_parent[s]] = s;
+        }
+    }
+
+    factors->row_order = calloc(supernodes, sizeof(int *));
+    factors->L_blocks = calloc(supernodes, sizeof(double *));
+    factors->U_blocks = calloc(supernodes, sizeof(double *));
+
+    for (int s = 0; s < supernodes && status == OK; s++)
+    {
+        int first = factors->first[s];
+        int last = factors->first[s + 1] - 1;
+        int k = last - first + 1;
+        int r = factors->structure_size[s];
+        int m = k + r;
+        int *rows = factors->structure[s];
+
+        for (int c = 0; c < k; c++)
+        {
+            position[first + c] = c;
+        }
+        for (int a = 0; a < r; a++)
+        {
+            position[rows[a]] = k + a;
+        }
+
+        // Step 1: assemble the original entries whose smaller index is a column of this supernode
+        double **F = allocateMatrix(m, m);
+        for (int j = first; j <= last; j++)
+        {
+            int column = factors->perm[j];
+            for (int p = A->ptr[column]; p < A->ptr[column + 1]; p++)
+            {
+                int i = inverse[A->index[p]];
+                if (i >= first)
+                {
+                    F[position[i]][position[j]] += A->values[p];
+                }
+            }
+            for (int p = AT->ptr[column]; p < AT->ptr[column + 1]; p++)
+            {
+                int i = inverse[AT->index[p]];
+                if (i > last)
+                {
+                    F[position[j]][position[i]] += AT->values[p];
+                }
+            }
+        }
+
+        // Step 2: extend-add the contribution blocks of the children
+        for (int c = child_head[s]; c != -1; c = child_next[c])
+        {
+            int rc = factors->structure_size[c];
+            int *child_rows = factors->structure[c];
+            for (int a = 0; a < rc; a++)
+            {
+                double *target = F[position[child_rows[a]]];
+                for (int b = 0; b < rc; b++)
+                {
+                    target[position[child_rows[b]]] += contribution[c][a][b];
+                }
+            }
+            freeMatrix(contribution[c], rc);
+            contribution[c] = NULL;
+        }
+
+        // Step 3: F11 = P11^T * L11 * U11, row swaps exchange whole front rows so F12 follows
+        int *order = malloc(k * sizeof(int));
+        for (int c = 0; c < k; c++)
+        {
+            order[c] = first + c;
+        }
+        for (int c = 0; c < k; c++)
+        {
+            int pivot = c;
+            for (int i = c + 1; i < k; i++)
+            {
+                if (fabs(F[i][c]) > fabs(F[pivot][c]))
+                {
+                    pivot = i;
+                }
+            }
+            if (static_pivot == 0.0)
+            {
+                status = CALCULATION_ERROR;
+                break;
+            }
+            if (pivot != c)
+            {
+                double *row = F[c];
+                F[c] = F[pivot];
+                F[pivot] = row;
+                int index = order[c];
+                order[c] = order[pivot];
+                order[pivot] = index;
+            }
+            if (fabs(F[c][c]) < static_pivot)
+            {
+                F[c][c] = (F[c][c] < 0.0) ? -static_pivot : static_pivot;
+                factors->perturbed++;
+            }
+            for (int i = c + 1; i < k; i++)
+            {
+                double factor = F[i][c] / F[c][c];
+                F[i][c] = factor;
+                for (int j = c + 1; j < k; j++)
+                {
+                    F[i][j] -= factor * F[c][j];
+                }
+            }
+        }
+        factors->row_order[s] = order;
+        if (status != OK)
+        {
+            freeMatrix(F, m);
+            break;
+        }
+
+        if (r > 0)
+        {
+            // Step 4: U12 = L11^-1 * F12 and L21 = F21 * U11^-1
+            for (int i = 1; i < k; i++)
+            {
+                for (int p = 0; p < i; p++)
+                {
+                    double factor = F[i][p];
+                    for (int j = k; j < m; j++)
+                    {
+                        F[i][j] -= factor * F[p][j];
+                    }
+                }
+            }
+            for (int i = k; i < m; i++)
+            {
+                for (int c = 0; c < k; c++)
+                {
+                    double sum = F[i][c];
+                    for (int p = 0; p < c; p++)
+                    {
+                        sum -= F[i][p] * F[p][c];
+                    }
+                    F[i][c] = sum / F[c][c];
+                }
+            }
+
+            // Step 5: contribution block F22 - L21 * U12 through the dense multiplication kernel
+            double **L21 = malloc(r * sizeof(double *));
+            double **U12 = malloc(k * sizeof(double *));
+            for (int a = 0; a < r; a++)
+            {
+                L21[a] = F[k + a];
+            }
+            for (int c = 0; c < k; c++)
+            {
+                U12[c] = F[c] + k;
+            }
+            double **update = allocateMatrix(r, r);
+            Naive_matrix_multiplication(L21, U12, update, r, k, r);
+            for (int a = 0; a < r; a++)
+            {
+                for (int b = 0; b < r; b++)
+                {
+                    update[a][b] = F[k + a][k + b] - update[a][b];
+                }
+            }
+            contribution[s] = update;
+            free(L21);
+            free(U12);
+        }
+
+        // Step 6: keep the pivot columns (L) and pivot rows (U) of the front
+        double *L_block = malloc(m * k * sizeof(double));
+        double *U_block = malloc(k * m * sizeof(double));
+        for (int i = 0; i < m; i++)
+        {
+            memcpy(&L_block[i * k], F[i], k * sizeof(double));
+        }
+        for (int i = 0; i < k; i++)
+        {
+            memcpy(&U_block[i * m], F[i], m * sizeof(double));
+        }
+        factors->L_blocks[s] = L_block;
+        factors->U_blocks[s] = U_block;
+        freeMatrix(F, m);
+    }
+
+    for (int s = 0; s < supernodes; s++)
+    {
+        if (contribution[s] != NULL)
+        {
+            freeMatrix(contribution[s], factors->structure_size[s]);
+        }
+    }
+    free(contribution);
+    free(child_head);
+    free(child_next);
+    free(inverse);
+    free(position);
+    return status;
+}
+
+void SparseLU_Free(sparse_lu_t *factors)
+{
+    for (int s = 0; s < factors->supernodes; s++)
+    {
+        free(factors->structure[s]);
+        free(factors->row_order[s]);
+        free(factors->L_blocks[s]);
+        free(factors->U_blocks[s]);
+    }
+    free(factors->structure);
+    free(factors->structure_size);
+    free(factors->row_order);
+    free(factors->L_blocks);
+    free(factors->U_blocks);
+    free(factors->first);
+    free(factors->perm);
+    free(factors->row_match);
+}
+
+// Sparse LU: maximum transversal, symbolic analysis, then the supernodal numeric factorization
+// Nothing is left to free when it fails
+int SparseLU_Factorize(sparse_matrix_t *A, sparse_lu_t *factors)
+{
+    if (A == NULL || factors == NULL || A->rows != A->columns)
+    {
+        return INCORRECT_MATRIX;
+    }
+
+    int n = A->columns;
+    factors->row_match = malloc(n * sizeof(int));
+    factors->supernodes = 0;
+    int status = maximumTransversal(A, factors->row_match);
+    if (status != OK)
+    {
+        free(factors->row_match);
+        return status;
+    }
+
+    // Q * A: row row_match[j] of A becomes row j
+    sparse_matrix_t QA, QAT;
+    int *new_row = malloc(n * sizeof(int));
+    for (int j = 0; j < n; j++)
+    {
+        new_row[factors->row_match[j]] = j;
+    }
+    createSparseMatrix(n, n, A->nnz, &QA);
+    memcpy(QA.ptr, A->ptr, (n + 1) * sizeof(int));
+    memcpy(QA.values, A->values, A->nnz * sizeof(double));
+    for (int p = 0; p < A->nnz; p++)
+    {
+        QA.index[p] = new_row[A->index[p]];
+    }
+    free(new_row);
+    transposeSparse(&QA, &QAT);
+
+    int *supernode_parent;
+    symbolicAnalysis(&QA, &QAT, factors, &supernode_parent);
+    status = numericFactorization(&QA, &QAT, factors, supernode_parent);
+    if (status != OK)
+    {
+        SparseLU_Free(factors);
+    }
+
+    free(supernode_parent);
+    freeSparseMatrix(&QA);
+    freeSparseMatrix(&QAT);
+    return status;
+}
+
+// Number of entries stored in L and U
+long SparseLU_Nonzeros(sparse_lu_t *factors)
+{
+    long nnz = 0;
+    for (int s = 0; s < factors->supernodes; s++)
+    {
+        long k = factors->first[s + 1] - factors->first[s];
+        long m = k + factors->structure_size[s];
+        nnz += 2 * m * k - k;
+    }
+    return nnz;
+}
+
+// Solve A x = b with the supernodal factors
+void SparseLU_Solve(sparse_lu_t *factors, double *b, double *x)
+{
+    int n = factors->n;
+    double *y = malloc(n * sizeof(double));
+    double *pivots = malloc(n * sizeof(double));
+    for (int k = 0; k < n; k++)
+    {
+        y[k] = b[factors->row_match[factors->perm[k]]];
+    }
+
+    // Forward: every supernode first reorders its rows as its pivoting did, then solves with L11 and updates below
+    for (int s = 0; s < factors->supernodes; s++)
+    {
+        int first = factors->first[s];
+        int k = factors->first[s + 1] - first;
+        int r = factors->structure_size[s];
+        double *L = factors->L_blocks[s];
+
+        for (int c = 0; c < k; c++)
+        {
+            pivots[c] = y[factors->row_order[s][c]];
+        }
+        for (int c = 0; c < k; c++)
+        {
+            for (int p = 0; p < c; p++)
+            {
+                pivots[c] -= L[c * k + p] * pivots[p];
+            }
+            y[first + c] = pivots[c];
+        }
+        for (int a = 0; a < r; a++)
+        {
+            double sum = 0.0;
+            for (int p = 0; p < k; p++)
+            {
+                sum += L[(k + a) * k + p] * pivots[p];
+            }
+            y[factors->structure[s][a]] -= sum;
+        }
+    }
+
+    // Backward: U11 x_s = y_s - U12 * x_R, from the last supernode to the first
+    for (int s = factors->supernodes - 1; s >= 0; s--)
+    {
+        int first = factors->first[s];
+        int k = factors->first[s + 1] - first;
+        int r = factors->structure_size[s];
+        int m = k + r;
+        double *U = factors->U_blocks[s];
+
+        for (int c = k - 1; c >= 0; c--)
+        {
+            double sum = y[first + c];
+            for (int a = 0; a < r; a++)
+            {
+                sum -= U[c * m + k + a] * y[factors->structure[s][a]];
+            }
+            for (int p = c + 1; p < k; p++)
+            {
+                sum -= U[c * m + p] * y[first + p];
+            }
+            y[first + c] = sum / U[c * m + c];
+        }
+    }
+
+    for (int k = 0; k < n; k++)
+    {
+        x[factors->perm[k]] = y[k];
+    }
+    free(y);
+    free(pivots);
+}
+
+// Componentwise backward error of x: max_i |b - A x|_i / (|A| |x| + |b|)_i, the residual is left in r
+double backwardError(sparse_matrix_t *A, double *b, double *x, double *r)
+{
+    int n = A->columns;
+    double *scale = malloc(n * sizeof(double));
+    for (int i = 0; i < n; i++)
+    {
+        r[i] = b[i];
+        scale[i] = fabs(b[i]);
+    }
+    for (int j = 0; j < n; j++)
+    {
+        for (int p = A->ptr[j]; p < A->ptr[j + 1]; p++)
+        {
+            r[A->index[p]] -= A->values[p] * x[j];
+            scale[A->index[p]] += fabs(A->values[p] * x[j]);
+        }
+    }
+
+    double error = 0.0;
+    for (int i = 0; i < n; i++)
+    {
+        if (scale[i] > 0.0)
+        {
+            double ratio = fabs(r[i]) / scale[i];
+            if (ratio > error)
+            {
+                error = ratio;
+            }
+        }
+        else if (r[i] != 0.0)
+        {
+            error = INFINITY;
+        }
+    }
+    free(scale);
+    return error;
+}
+
+// Solve A x = b with the supernodal factors, then refine x with them until the backward error stops halving
+// CALCULATION_ERROR means the restricted (or static) pivoting lost too much: x is not accurate, use the fallback
+int SparseLU_SolveRefined(sparse_matrix_t *A, sparse_lu_t *factors, double *b, double *x, double *error)
+{
+    int n = A->columns;
+    double *r = malloc(n * sizeof(double));
+    double *dx = malloc(n * sizeof(double));
+
+    SparseLU_Solve(factors, b, x);
+    *error = backwardError(A, b, x, r);
+    for (int step = 0; step < REFINEMENT_STEPS && *error > DBL_EPSILON; step++)
+    {
+        SparseLU_Solve(factors, r, dx);
+        for (int i = 0; i < n; i++)
+        {
+            dx[i] += x[i];
+        }
+        double new_error = backwardError(A, b, dx, r);
+        if (!(new_error < *error))
+        {
+            break;
+        }
+        memcpy(x, dx, n * sizeof(double));
+        int stagnated = new_error > 0.5 * *error;
+        *error = new_error;
+        if (stagnated)
+        {
+            break;
+        }
+    }
+
+    free(r);
+    free(dx);
+    return (*error <= BACKWARD_ERROR_LIMIT) ? OK : CALCULATION_ERROR;
+}
+
+// Dense LU with partial pivoting over all rows, used when the supernodal factors cannot give an accurate x
+// CALCULATION_ERROR here means A is singular; INCORRECT_MATRIX when n is above DENSE_FALLBACK_LIMIT
+int denseFallbackSolve(sparse_matrix_t *A, double *b, double *x)
+{
+    int n = A->columns;
+    if (n > DENSE_FALLBACK_LIMIT)
+    {
+        return INCORRECT_MATRIX;
+    }
+    double **LU = allocateMatrix(n, n);
+    for (int i = 0; i < n; i++)
+    {
+        memset(LU[i], 0, n * sizeof(double));
+    }
+    for (int j = 0; j < n; j++)
+    {
+        for (int p = A->ptr[j]; p < A->ptr[j + 1]; p++)
+        {
+            LU[A->index[p]][j] += A->values[p];
+        }
+    }
+    memcpy(x, b, n * sizeof(double));
+
+    int status = OK;
+    for (int c = 0; c < n && status == OK; c++)
+    {
+        int pivot = c;
+        for (int i = c + 1; i < n; i++)
+        {
+            if (fabs(LU[i][c]) > fabs(LU[pivot][c]))
+            {
+                pivot = i;
+            }
+        }
+        if (LU[pivot][c] == 0.0)
+        {
+            status = CALCULATION_ERROR;
+            break;
+        }
+        if (pivot != c)
+        {
+            double *row = LU[c];
+            LU[c] = LU[pivot];
+            LU[pivot] = row;
+            double value = x[c];
+            x[c] = x[pivot];
+            x[pivot] = value;
+        }
+        for (int i = c + 1; i < n; i++)
+        {
+            double factor = LU[i][c] / LU[c][c];
+            for (int j = c + 1; j < n; j++)
+            {
+                LU[i][j] -= factor * LU[c][j];
+            }
+            x[i] -= factor * x[c];
+        }
+    }
+
+    if (status == OK)
+    {
+        for (int i = n - 1; i >= 0; i--)
+        {
+            for (int j = i + 1; j < n; j++)
+            {
+                x[i] -= LU[i][j] * x[j];
+            }
+            x[i] /= LU[i][i];
+        }
+    }
+
+    freeMatrix(LU, n);
+    return status;
+}
+
+int main()
+{
+    clock_t start_time, end_time;
+    int n, nnz;
+
+    // Step 1: Get dimensions for Matrix A and its number of nonzeros
+    printf("\nChoose Matrix Dimension for the square matrix: ");
+    scanf("%d", &n);
+    printf("\nChoose the number of nonzero elements: ");
+    scanf("%d", &nnz);
+
+    // Error condition 1
+    if (n <= 0 || nnz <= 0)
+    {
+        printf("Matrix Size and number of nonzeros can only be larger than zero, the program will exit...");
+        exit(1);
+    }
+
+    // Step 2: Allocate memory
+    int *rows = malloc(nnz * sizeof(int));
+    int *columns = malloc(nnz * sizeof(int));
+    double *values = malloc(nnz * sizeof(double));
+    double *b = malloc(n * sizeof(double));
+    double *x = malloc(n * sizeof(double));
+
+    // Note: You can either enter the matrix input manually, or choose to fill the matrices automatically. But make sure to comment the input loops, and to uncomment the alternative random input option.
+    // Step 3: Asking the user to input the nonzero elements of A as (row, column, value) and the right-hand side b
+    printf("Input the nonzero elements of Matrix A as: row column value\n");
+    for (int t = 0; t < nnz; t++)
+    {
+        printf("A entry %d=", t);
+        scanf("%d %d %lf", &rows[t], &columns[t], &values[t]);
+    }
+    printf("Input Vector b Elements:\n");
+    for (int i = 0; i < n; i++)
+    {
+        printf("b[%d]=", i);
+        scanf("%lf", &b[i]);
+    }
+
+    // This is an alternative input option: the 5-point Laplacian of a g x g grid (n = g * g, nnz = 5 * n), but make sure to comment the input loops.
+    /*int g = (int)sqrt((double)n);
+    nnz = 0;
+    for (int i = 0; i < g * g; i++)
+    {
+        int neighbours[4] = {i - 1, i + 1, i - g, i + g};
+        rows[nnz] = i; columns[nnz] = i; values[nnz++] = 4.0;
+        for (int d = 0; d < 4; d++)
+        {
+            if (neighbours[d] >= 0 && neighbours[d] < g * g && (d >= 2 || neighbours[d] / g == i / g))
+            {
+                rows[nnz] = i; columns[nnz] = neighbours[d]; values[nnz++] = -1.0;
+            }
+        }
+        b[i] = (double)rand() / RAND_MAX;
+    }
+    n = g * g;*/
+
+    sparse_matrix_t A;
+    if (tripletsToCSC(n, nnz, rows, columns, values, &A) != OK)
+    {
+        printf("Matrix entries are out of range, the program will exit...");
+        exit(1);
+    }
+
+    // Step 4: Factorize and solve, falling back to dense pivoted LU when the sparse solution is not accurate
+    sparse_lu_t factors;
+    int method = SPARSE_LU_SOLVE;
+    double error = INFINITY;
+    start_time = clock();
+    int status = SparseLU_Factorize(&A, &factors);
+    end_time = clock();
+    int factorized = status == OK;
+    if (status == OK)
+    {
+        printf("Time taken for Sparse LU Factorization: %.6f seconds\n", (double)(end_time - start_time) / CLOCKS_PER_SEC);
+        printf("Supernodes: %d, nonzeros in A: %d, nonzeros in L + U: %ld, perturbed pivots: %d\n", factors.supernodes, nnz,
+               SparseLU_Nonzeros(&factors), factors.perturbed);
+
+        start_time = clock();
+        status = SparseLU_SolveRefined(&A, &factors, b, x, &error);
+        end_time = clock();
+        printf("Time taken for the Sparse Solve: %.6f seconds\n", (double)(end_time - start_time) / CLOCKS_PER_SEC);
+        SparseLU_Free(&factors);
+    }
+    // Error condition 2
+    if (status != OK && n > DENSE_FALLBACK_LIMIT)
+    {
+        if (factorized)
+        {
+            printf("Sparse LU did not reach an accurate solution (backward error %.3e) and n = %d is too large for the dense fallback, the program will exit...",
+                   error, n);
+        }
+        else
+        {
+            printf("Sparse LU factorization failed (structurally singular or zero matrix) and n = %d is too large for the dense fallback, the program will exit...", n);
+        }
+        exit(1);
+    }
+    if (status != OK)
+    {
+        method = DENSE_LU_FALLBACK;
+        start_time = clock();
+        status = denseFallbackSolve(&A, b, x);
+        end_time = clock();
+        printf("Time taken for the Dense LU fallback: %.6f seconds\n", (double)(end_time - start_time) / CLOCKS_PER_SEC);
+    }
+
+    // Error condition 3
+    if (status != OK)
+    {
+        printf("Matrix is singular, the program will exit...");
+        exit(1);
+    }
+
+    // Step 5: Print results
+    if (method == SPARSE_LU_SOLVE)
+    {
+        printf("Solved with the supernodal factors, backward error: %.3e\n", error);
+    }
+    else
+    {
+        printf("Solved with the dense pivoted LU fallback\n");
+    }
+    printf("Solution x:\n");
+    for (int i = 0; i < n; i++)
+    {
+        printf("%10.4f\n", x[i]);
+    }
+
+    // Step 6: Free memory
+    freeSparseMatrix(&A);
+    free(rows);
+    free(columns);
+    free(values);
+    free(b);
+    free(x);
+
+    return 0;
+}
@@ -7,6 +7,7 @@ Tan Viet Nguyen - 21400381
 
 */
 #include <math.h>
+#include <float.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -15,6 +16,12 @@ Tan Viet Nguyen - 21400381
 #define SUCCESS 1
 #define FAILURE 0
 
+// a block whose inverse is this much larger than its parent matrix counts as a bad pivot block
+#define GROWTH_LIMIT 1e10
+
+// Blocks up to this size are inverted by the unrolled fixed-size kernels
+#define SMALL_INVERSE_SIZE 8
+
 enum ERROR_CODES
 {
   OK,
@@ -22,6 +29,14 @@ enum ERROR_CODES
   CALCULATION_ERROR
 };
 
+// structure flags of the blocks in inverse(), products with a zero or identity operand cost no flops
+enum BLOCK_STRUCTURES
+{
+  GENERAL_BLOCK,
+  ZERO_BLOCK,
+  IDENTITY_BLOCK
+};
+
 typedef struct matrix_struct
 {
   double **matrix;
@@ -56,9 +71,8 @@ int create_matrix(int rows, int columns, matrix_t *result)
     {
       // allocating one block of memory for everything at once
       double *start = (double *)(result->matrix + rows);
-      // indexing our matrix
-      int iteration_limit = rows <= columns ? columns : rows;
-      for (int i = 0; i < iteration_limit; i++)
+      // indexing our matrix, one pointer per row (the blocks of an uneven split are rectangular)
+      for (int i = 0; i < rows; i++)
       {
         result->matrix[i] = start + i * columns;
       }
@@ -173,6 +187,88 @@ int mult_matrix(matrix_t *A, matrix_t *B, matrix_t *result)
   return error_code;
 }
 
+// zero: every entry is 0, identity: square with ones on the diagonal only, general: anything else
+// one early-exit scan per block, the flags of the blocks computed from them are derived without scanning
+int block_structure(matrix_t *A)
+{
+  int zero = 1;
+  int identity = A->rows == A->columns;
+  for (int i = 0; i < A->rows && (zero || identity); i++)
+  {
+    for (int j = 0; j < A->columns && (zero || identity); j++)
+    {
+      double value = A->matrix[i][j];
+      if (value != 0.0)
+      {
+        zero = 0;
+      }
+      if (value != (i == j ? 1.0 : 0.0))
+      {
+        identity = 0;
+      }
+    }
+  }
+
+  if (zero)
+  {
+    return ZERO_BLOCK;
+  }
+  return identity ? IDENTITY_BLOCK : GENERAL_BLOCK;
+}
+
+// structure of A * B from the structures of A and B
+int product_structure(int structure_A, int structure_B)
+{
+  if (structure_A == ZERO_BLOCK || structure_B == ZERO_BLOCK)
+  {
+    return ZERO_BLOCK;
+  }
+  if (structure_A == IDENTITY_BLOCK)
+  {
+    return structure_B;
+  }
+  if (structure_B == IDENTITY_BLOCK)
+  {
+    return structure_A;
+  }
+  return GENERAL_BLOCK;
+}
+
+// result = A * B, a zero operand gives the zero matrix and an identity operand a copy of the other one,
+// only two general operands go through mult_matrix
+int mult_matrix_structured(matrix_t *A, int structure_A, matrix_t *B, int structure_B, matrix_t *result)
+{
+  if (validate_matrix(2, A, B) || result == NULL)
+  {
+    return INCORRECT_MATRIX;
+  }
+  else if (A->columns != B->rows)
+  {
+    return CALCULATION_ERROR;
+  }
+
+  if (structure_A != ZERO_BLOCK && structure_B != ZERO_BLOCK &&
+      structure_A != IDENTITY_BLOCK && structure_B != IDENTITY_BLOCK)
+  {
+    return mult_matrix(A, B, result);
+  }
+
+  int error_code = create_matrix(A->rows, B->columns, result);
+  if (!error_code && structure_A != ZERO_BLOCK && structure_B != ZERO_BLOCK)
+  {
+    matrix_t *source = (structure_A == IDENTITY_BLOCK) ? B : A;
+    for (int i = 0; i < result->rows; i++)
+    {
+      for (int j = 0; j < result->columns; j++)
+      {
+        result->matrix[i][j] = source->matrix[i][j];
+      }
+    }
+  }
+
+  return error_code;
+}
+
 int is_matrix_same_size(int matrix_amount, matrix_t *A, ...)
 {
   if (A == NULL)
@@ -263,6 +359,16 @@ int sum_matrix(matrix_t *A, matrix_t *B, matrix_t *result)
   return error_code;
 }
 
+// free a matrix made by create_matrix (rows and entries are one block)
+void remove_matrix(matrix_t *A)
+{
+  if (A != NULL && A->matrix != NULL)
+  {
+    free(A->matrix);
+    A->matrix = NULL;
+  }
+}
+
 void get_identity_matrix(int n, matrix_t *result)
 {
   create_matrix(n, n, result);
@@ -313,7 +419,7 @@ void merge_matrices(matrix_t *first_matrix, matrix_t *second_matrix,
   {
     for (int j = 0; j < third_matrix->columns; j++)
     {
-      filled_matrix->matrix[third_matrix->rows + i][j] = third_matrix->matrix[i][j];
+      filled_matrix->matrix[first_matrix->rows + i][j] = third_matrix->matrix[i][j];
     }
   }
 
@@ -321,7 +427,7 @@ void merge_matrices(matrix_t *first_matrix, matrix_t *second_matrix,
   {
     for (int j = 0; j < fourth_matrix->columns; j++)
     {
-      filled_matrix->matrix[fourth_matrix->rows + i][fourth_matrix->columns + j] = fourth_matrix->matrix[i][j];
+      filled_matrix->matrix[first_matrix->rows + i][first_matrix->columns + j] = fourth_matrix->matrix[i][j];
     }
   }
 }
@@ -330,8 +436,9 @@ void split_matrix_into_quadrants(matrix_t *A,
                                  matrix_t *top_left, matrix_t *top_right,
                                  matrix_t *bottom_left, matrix_t *bottom_right)
 {
+  // the top left block takes the larger half when the size is odd
   int size = A->rows;
-  int split_point = size / 2;
+  int split_point = (size + 1) / 2;
 
   for (int i = 0; i < split_point; i++)
   {
@@ -366,216 +473,545 @@ void split_matrix_into_quadrants(matrix_t *A,
   }
 }
 
-float randomFloat()
+// infinity norm (largest absolute row sum)
+double norm_inf(matrix_t *A)
 {
-  double randnumber = rand();
-  return (float)(randnumber) / (float)(randnumber + rand());
+  double norm = 0;
+  for (int i = 0; i < A->rows; i++)
+  {
+    double sum = 0;
+    for (int j = 0; j < A->columns; j++)
+    {
+      sum += fabs(A->matrix[i][j]);
+    }
+    if (sum > norm)
+    {
+      norm = sum;
+    }
+  }
+  return norm;
 }
 
-void inverse(matrix_t *A, matrix_t *inv_A)
+// pivoted LU leaf: inv_A = A^-1 from P * A = L * U, solved one column of the identity at a time
+// used by inverse() on a subproblem whose leading block or Schur complement is singular or ill-conditioned
+int lu_inverse(matrix_t *A, matrix_t *inv_A)
 {
-  if (A->columns == 1 && A->rows == 1)
+  int n = A->rows;
+  matrix_t LU = {};
+  if (create_matrix(n, n, &LU))
   {
-    if (A->matrix[0][0] == 0)
+    return INCORRECT_MATRIX;
+  }
+  int *perm = (int *)malloc(n * sizeof(int));
+  double *column = (double *)malloc(n * sizeof(double));
+  int error_code = OK;
+
+  for (int i = 0; i < n; i++)
+  {
+    for (int j = 0; j < n; j++)
+    {
+      LU.matrix[i][j] = A->matrix[i][j];
+    }
+    perm[i] = i;
+  }
+
+  for (int k = 0; k < n && error_code == OK; k++)
+  {
+    int pivot = k;
+    for (int i = k + 1; i < n; i++)
+    {
+      if (fabs(LU.matrix[i][k]) > fabs(LU.matrix[pivot][k]))
+      {
+        pivot = i;
+      }
+    }
+    if (LU.matrix[pivot][k] == 0)
     {
-      printf("Cannot devide by 0!!\n");
+      error_code = CALCULATION_ERROR;
     }
     else
     {
-      inv_A->matrix[0][0] = 1 / A->matrix[0][0];
+      double *row = LU.matrix[k];
+      LU.matrix[k] = LU.matrix[pivot];
+      LU.matrix[pivot] = row;
+      int index = perm[k];
+      perm[k] = perm[pivot];
+      perm[pivot] = index;
+
+      for (int i = k + 1; i < n; i++)
+      {
+        LU.matrix[i][k] /= LU.matrix[k][k];
+        for (int j = k + 1; j < n; j++)
+        {
+          LU.matrix[i][j] -= LU.matrix[i][k] * LU.matrix[k][j];
+        }
+      }
     }
   }
-  else if (A->rows == 2 && A->columns == 2)
-  {
-    matrix_t A_11 = {};
-    create_matrix(1, 1, &A_11);
-    A_11.matrix[0][0] = A->matrix[0][0];
 
-    matrix_t A_12 = {};
-    create_matrix(1, 1, &A_12);
-    A_12.matrix[0][0] = A->matrix[0][1];
-
-    matrix_t A_21 = {};
-    create_matrix(1, 1, &A_21);
-    A_21.matrix[0][0] = A->matrix[1][0];
-
-    matrix_t A_22 = {};
-    create_matrix(1, 1, &A_22);
-    A_22.matrix[0][0] = A->matrix[1][1];
-
-    matrix_t A_11_inv = {};
-    create_matrix(1, 1, &A_11_inv);
-    inverse(&A_11, &A_11_inv);
-
-    matrix_t A_21_A_11_inv = {};
-    create_matrix(1, 1, &A_21_A_11_inv);
-
-    mult_matrix(&A_21, &A_11_inv, &A_21_A_11_inv);
+  // column j of A^-1 solves L * U * x = P * e_j
+  for (int j = 0; j < n && error_code == OK; j++)
+  {
+    for (int i = 0; i < n; i++)
+    {
+      column[i] = (perm[i] == j) ? 1 : 0;
+      for (int p = 0; p < i; p++)
+      {
+        column[i] -= LU.matrix[i][p] * column[p];
+      }
+    }
+    for (int i = n - 1; i >= 0; i--)
+    {
+      for (int p = i + 1; p < n; p++)
+      {
+        column[i] -= LU.matrix[i][p] * column[p];
+      }
+      column[i] /= LU.matrix[i][i];
+      inv_A->matrix[i][j] = column[i];
+    }
+  }
 
-    matrix_t A_21_A_11_inv_A_12 = {};
-    create_matrix(1, 1, &A_21_A_11_inv_A_12);
+  // the row pointers were swapped, but the whole matrix is still the single block starting at LU.matrix
+  free(LU.matrix);
+  free(perm);
+  free(column);
+  return error_code;
+}
 
-    mult_matrix(&A_21_A_11_inv, &A_12, &A_21_A_11_inv_A_12);
+// Small fixed-size inverses on flat row-major arrays (A[i * n + j]), the base case of the recursive inversion
+// and usable directly when many small matrices have to be inverted
+// The determinant comes back as log|det(A)| and its sign, built up pivot by pivot (or from the scaled closed form),
+// so a block of very large or very small entries cannot overflow or underflow it
+// CALCULATION_ERROR when A is singular to working precision (a pivot or det lost in the rounding of its own terms)
+// or when its inverse has a non-finite entry; inverse() then retries the block with lu_inverse
+// This file and the Strassen-multiplication inversion are separate programs, one source file each, so both hold
+// the same kernels apart from indentation; keep them in step
+
+// largest |a_ij| of a flat block
+static inline double max_abs(const double *A, const int count)
+{
+  double scale = 0.0;
+  for (int i = 0; i < count; i++)
+  {
+    if (fabs(A[i]) > scale)
+    {
+      scale = fabs(A[i]);
+    }
+  }
+  return scale;
+}
 
-    matrix_t S_22 = {};
-    create_matrix(1, 1, &S_22);
+// 1 when every entry of a flat block is finite
+static inline int all_finite(const double *A, const int count)
+{
+  for (int i = 0; i < count; i++)
+  {
+    if (!isfinite(A[i]))
+    {
+      return 0;
+    }
+  }
+  return 1;
+}
 
-    sub_matrix(&A_22, &A_21_A_11_inv_A_12, &S_22);
+// 2x2 closed form on B = A / s with s = max|a_ij|: A^-1 = adj(B) / (det(B) * s)
+// Scaling first keeps det(B) and the adjugate in range for blocks such as 1e-160 * I or 1e160 * I
+int invert_2x2(const double *A, double *A_inv, double *log_abs_det, int *det_sign)
+{
+  double s = max_abs(A, 4);
+  if (s == 0.0 || !isfinite(s))
+  {
+    return CALCULATION_ERROR;
+  }
+  double B[4];
+  for (int i = 0; i < 4; i++)
+  {
+    B[i] = A[i] / s;
+  }
 
-    matrix_t S_22_inv = {};
-    create_matrix(1, 1, &S_22_inv);
-    inverse(&S_22, &S_22_inv);
+  double d = B[0] * B[3] - B[1] * B[2];
+  if (fabs(d) <= 2 * DBL_EPSILON * (fabs(B[0] * B[3]) + fabs(B[1] * B[2])))
+  {
+    return CALCULATION_ERROR;
+  }
+  double r = 1.0 / d;
+  A_inv[0] = B[3] * r / s;
+  A_inv[1] = -B[1] * r / s;
+  A_inv[2] = -B[2] * r / s;
+  A_inv[3] = B[0] * r / s;
+  *log_abs_det = log(fabs(d)) + 2 * log(s);
+  *det_sign = (d > 0) ? 1 : -1;
+  return all_finite(A_inv, 4) ? OK : CALCULATION_ERROR;
+}
 
-    matrix_t A_12_S_22_inv = {};
-    create_matrix(1, 1, &A_12_S_22_inv);
-    mult_matrix(&A_12, &S_22_inv, &A_12_S_22_inv);
+// 3x3 closed form on B = A / s: cofactors of the first row give det(B), the adjugate is the transposed
+// cofactor matrix, and A^-1 = adj(B) / (det(B) * s)
+int invert_3x3(const double *A, double *A_inv, double *log_abs_det, int *det_sign)
+{
+  double s = max_abs(A, 9);
+  if (s == 0.0 || !isfinite(s))
+  {
+    return CALCULATION_ERROR;
+  }
+  double B[9];
+  for (int i = 0; i < 9; i++)
+  {
+    B[i] = A[i] / s;
+  }
 
-    matrix_t A_12_S_22_inv_A_21 = {};
-    create_matrix(1, 1, &A_12_S_22_inv_A_21);
+  double c00 = B[4] * B[8] - B[5] * B[7];
+  double c01 = B[5] * B[6] - B[3] * B[8];
+  double c02 = B[3] * B[7] - B[4] * B[6];
+  double d = B[0] * c00 + B[1] * c01 + B[2] * c02;
+  if (fabs(d) <= 4 * DBL_EPSILON * (fabs(B[0] * c00) + fabs(B[1] * c01) + fabs(B[2] * c02)))
+  {
+    return CALCULATION_ERROR;
+  }
+  double r = 1.0 / d;
+  A_inv[0] = c00 * r / s;
+  A_inv[1] = (B[2] * B[7] - B[1] * B[8]) * r / s;
+  A_inv[2] = (B[1] * B[5] - B[2] * B[4]) * r / s;
+  A_inv[3] = c01 * r / s;
+  A_inv[4] = (B[0] * B[8] - B[2] * B[6]) * r / s;
+  A_inv[5] = (B[2] * B[3] - B[0] * B[5]) * r / s;
+  A_inv[6] = c02 * r / s;
+  A_inv[7] = (B[1] * B[6] - B[0] * B[7]) * r / s;
+  A_inv[8] = (B[0] * B[4] - B[1] * B[3]) * r / s;
+  *log_abs_det = log(fabs(d)) + 3 * log(s);
+  *det_sign = (d > 0) ? 1 : -1;
+  return all_finite(A_inv, 9) ? OK : CALCULATION_ERROR;
+}
 
-    mult_matrix(&A_12_S_22_inv, &A_21, &A_12_S_22_inv_A_21);
+// Gauss-Jordan with partial pivoting on [A | I] held in local arrays
+// Every caller passes a constant N, so after inlining all loop bounds are known and the compiler unrolls
+// and vectorizes the row updates; rows are swapped by index through perm instead of moving data
+// A pivot is lost when it is below N * eps times the largest original entry of its own column, so a badly
+// scaled but invertible matrix such as diag(1, 1, 1, 1e-20) is not mistaken for a singular one
+static inline int gauss_jordan_fixed(const double *A, double *A_inv, double *log_abs_det, int *det_sign, const int N)
+{
+  double a[SMALL_INVERSE_SIZE][SMALL_INVERSE_SIZE];
+  double x[SMALL_INVERSE_SIZE][SMALL_INVERSE_SIZE];
+  int perm[SMALL_INVERSE_SIZE];
+  double log_det = 0.0;
+  int sign = 1;
+  double scale[SMALL_INVERSE_SIZE];
+
+  for (int j = 0; j < N; j++)
+  {
+    scale[j] = 0.0;
+  }
+  for (int i = 0; i < N; i++)
+  {
+    perm[i] = i;
+    for (int j = 0; j < N; j++)
+    {
+      a[i][j] = A[i * N + j];
+      x[i][j] = (i == j) ? 1.0 : 0.0;
+      if (fabs(a[i][j]) > scale[j])
+      {
+        scale[j] = fabs(a[i][j]);
+      }
+    }
+  }
 
-    matrix_t A_12_S_22_inv_A_21_A_11_inv = {};
-    create_matrix(1, 1, &A_12_S_22_inv_A_21_A_11_inv);
+  for (int k = 0; k < N; k++)
+  {
+    int pivot = k;
+    for (int i = k + 1; i < N; i++)
+    {
+      if (fabs(a[perm[i]][k]) > fabs(a[perm[pivot]][k]))
+      {
+        pivot = i;
+      }
+    }
+    if (pivot != k)
+    {
+      int index = perm[k];
+      perm[k] = perm[pivot];
+      perm[pivot] = index;
+      sign = -sign;
+    }
+    int p = perm[k];
+    double pivot_value = a[p][k];
+    if (fabs(pivot_value) <= N * DBL_EPSILON * scale[k])
+    {
+      return CALCULATION_ERROR;
+    }
+    log_det += log(fabs(pivot_value));
+    if (pivot_value < 0)
+    {
+      sign = -sign;
+    }
 
-    mult_matrix(&A_12_S_22_inv_A_21, &A_11_inv, &A_12_S_22_inv_A_21_A_11_inv);
+    double r = 1.0 / pivot_value;
+    for (int j = 0; j < N; j++)
+    {
+      a[p][j] *= r;
+      x[p][j] *= r;
+    }
+    for (int i = 0; i < N; i++)
+    {
+      if (i == p)
+      {
+        continue;
+      }
+      double factor = a[i][k];
+      for (int j = 0; j < N; j++)
+      {
+        a[i][j] -= factor * a[p][j];
+        x[i][j] -= factor * x[p][j];
+      }
+    }
+  }
 
-    A_12_S_22_inv_A_21_A_11_inv.matrix[0][0] += 1;
+  // row k of the inverse sits in the row that was chosen as pivot k
+  for (int k = 0; k < N; k++)
+  {
+    for (int j = 0; j < N; j++)
+    {
+      A_inv[k * N + j] = x[perm[k]][j];
+    }
+  }
+  *log_abs_det = log_det;
+  *det_sign = sign;
+  return all_finite(A_inv, N * N) ? OK : CALCULATION_ERROR;
+}
 
-    matrix_t B_11 = {};
-    create_matrix(1, 1, &B_11);
-    mult_matrix(&A_11_inv, &A_12_S_22_inv_A_21_A_11_inv, &B_11);
+int invert_4x4(const double *A, double *A_inv, double *log_abs_det, int *det_sign)
+{
+  return gauss_jordan_fixed(A, A_inv, log_abs_det, det_sign, 4);
+}
 
-    matrix_t A_11_inv_A_12 = {};
-    create_matrix(1, 1, &A_11_inv_A_12);
-    mult_matrix(&A_11_inv, &A_12, &A_11_inv_A_12);
-    matrix_t B_12 = {};
-    create_matrix(1, 1, &B_12);
-    mult_matrix(&A_11_inv_A_12, &S_22_inv, &B_12);
+int invert_5x5(const double *A, double *A_inv, double *log_abs_det, int *det_sign)
+{
+  return gauss_jordan_fixed(A, A_inv, log_abs_det, det_sign, 5);
+}
 
-    B_12.matrix[0][0] *= -1;
+int invert_6x6(const double *A, double *A_inv, double *log_abs_det, int *det_sign)
+{
+  return gauss_jordan_fixed(A, A_inv, log_abs_det, det_sign, 6);
+}
 
-    matrix_t S_22_inv_A_21 = {};
-    create_matrix(1, 1, &S_22_inv_A_21);
-    mult_matrix(&S_22_inv, &A_21, &S_22_inv_A_21);
+int invert_7x7(const double *A, double *A_inv, double *log_abs_det, int *det_sign)
+{
+  return gauss_jordan_fixed(A, A_inv, log_abs_det, det_sign, 7);
+}
 
-    matrix_t B_21 = {};
-    create_matrix(1, 1, &B_21);
-    mult_matrix(&S_22_inv_A_21, &A_11_inv, &B_21);
-    B_21.matrix[0][0] *= -1;
+int invert_8x8(const double *A, double *A_inv, double *log_abs_det, int *det_sign)
+{
+  return gauss_jordan_fixed(A, A_inv, log_abs_det, det_sign, 8);
+}
 
-    matrix_t B_22 = {};
-    create_matrix(1, 1, &B_22);
+// Dispatch on n = 1 .. SMALL_INVERSE_SIZE
+int invert_small(const double *A, double *A_inv, int n, double *log_abs_det, int *det_sign)
+{
+  switch (n)
+  {
+  case 1:
+    if (A[0] == 0.0)
+    {
+      return CALCULATION_ERROR;
+    }
+    A_inv[0] = 1.0 / A[0];
+    *log_abs_det = log(fabs(A[0]));
+    *det_sign = (A[0] > 0) ? 1 : -1;
+    return all_finite(A_inv, 1) ? OK : CALCULATION_ERROR;
+  case 2:
+    return invert_2x2(A, A_inv, log_abs_det, det_sign);
+  case 3:
+    return invert_3x3(A, A_inv, log_abs_det, det_sign);
+  case 4:
+    return invert_4x4(A, A_inv, log_abs_det, det_sign);
+  case 5:
+    return invert_5x5(A, A_inv, log_abs_det, det_sign);
+  case 6:
+    return invert_6x6(A, A_inv, log_abs_det, det_sign);
+  case 7:
+    return invert_7x7(A, A_inv, log_abs_det, det_sign);
+  case 8:
+    return invert_8x8(A, A_inv, log_abs_det, det_sign);
+  default:
+    return INCORRECT_MATRIX;
+  }
+}
 
-    B_22.matrix[0][0] = S_22_inv.matrix[0][0];
+float randomFloat()
+{
+  double randnumber = rand();
+  return (float)(randnumber) / (float)(randnumber + rand());
+}
 
-    merge_matrices(&B_11, &B_12, &B_21, &B_22, inv_A);
+// Block inversion through the Schur complement S_22 = A_22 - A_21 * A_11^-1 * A_12
+// When A_11 or S_22 is singular, or its inverse grows past GROWTH_LIMIT relative to A, only this subproblem
+// falls back to the pivoted LU leaf; CALCULATION_ERROR means A itself is singular
+// Every block carries a structure flag: the quadrants are scanned once, the flags of the products, of S_22
+// and of the inverses follow from them, so zero off-diagonal blocks and identity diagonal blocks
+// (block triangular or block diagonal inputs) skip their products instead of multiplying through them
+int inverse(matrix_t *A, matrix_t *inv_A)
+{
+  if (block_structure(A) == IDENTITY_BLOCK)
+  {
+    for (int i = 0; i < A->rows; i++)
+    {
+      for (int j = 0; j < A->columns; j++)
+      {
+        inv_A->matrix[i][j] = (i == j) ? 1.0 : 0.0;
+      }
+    }
+    return OK;
+  }
+  else if (A->rows <= SMALL_INVERSE_SIZE)
+  {
+    // unrolled kernel straight on the contiguous storage of create_matrix, no temporaries
+    double log_abs_det;
+    int det_sign;
+    if (invert_small(A->matrix[0], inv_A->matrix[0], A->rows, &log_abs_det, &det_sign) != OK)
+    {
+      // a pivot lost to rounding is not proof of singularity, let the pivoted LU leaf decide
+      return lu_inverse(A, inv_A);
+    }
+    return OK;
   }
-
   else
   {
-    int split_point = A->rows / 2;
+    // uneven split for odd sizes: A_11 is n1 x n1, A_22 is n2 x n2, A_12 and A_21 are rectangular
+    int n1 = (A->rows + 1) / 2;
+    int n2 = A->rows - n1;
     matrix_t A_11 = {};
-    create_matrix(split_point, split_point, &A_11);
+    create_matrix(n1, n1, &A_11);
 
     matrix_t A_12 = {};
-    create_matrix(split_point, split_point, &A_12);
+    create_matrix(n1, n2, &A_12);
 
     matrix_t A_21 = {};
-    create_matrix(split_point, split_point, &A_21);
+    create_matrix(n2, n1, &A_21);
 
     matrix_t A_22 = {};
-    create_matrix(split_point, split_point, &A_22);
+    create_matrix(n2, n2, &A_22);
 
     split_matrix_into_quadrants(A, &A_11, &A_12, &A_21, &A_22);
 
-    matrix_t id = {};
-    create_matrix(A_11.rows, A_11.rows, &id);
-    get_identity_matrix(A_11.rows, &id);
+    int A_11_structure = block_structure(&A_11);
+    int A_12_structure = block_structure(&A_12);
+    int A_21_structure = block_structure(&A_21);
+    int A_22_structure = block_structure(&A_22);
 
     matrix_t A_11_inv = {};
-    create_matrix(split_point, split_point, &A_11_inv);
+    create_matrix(n1, n1, &A_11_inv);
 
-    inverse(&A_11, &A_11_inv);
+    if (inverse(&A_11, &A_11_inv) != OK || norm_inf(&A_11_inv) * norm_inf(A) > GROWTH_LIMIT)
+    {
+      // bad leading block, invert this subproblem with the pivoted LU leaf
+      remove_matrix(&A_11);
+      remove_matrix(&A_12);
+      remove_matrix(&A_21);
+      remove_matrix(&A_22);
+      remove_matrix(&A_11_inv);
+      return lu_inverse(A, inv_A);
+    }
+    // an inverse is never zero, it is an identity only when the block is one
+    int A_11_inv_structure = (A_11_structure == IDENTITY_BLOCK) ? IDENTITY_BLOCK : GENERAL_BLOCK;
 
+    // the product, sum and difference helpers create their result matrix themselves
     matrix_t A_21_A_11_inv = {};
-    create_matrix(split_point, split_point, &A_21_A_11_inv);
-
-    mult_matrix(&A_21, &A_11_inv, &A_21_A_11_inv);
+    mult_matrix_structured(&A_21, A_21_structure, &A_11_inv, A_11_inv_structure, &A_21_A_11_inv);
+    int A_21_A_11_inv_structure = product_structure(A_21_structure, A_11_inv_structure);
 
     matrix_t A_21_A_11_inv_A_12 = {};
-    create_matrix(split_point, split_point, &A_21_A_11_inv_A_12);
-
-    mult_matrix(&A_21_A_11_inv, &A_12, &A_21_A_11_inv_A_12);
+    mult_matrix_structured(&A_21_A_11_inv, A_21_A_11_inv_structure, &A_12, A_12_structure, &A_21_A_11_inv_A_12);
+    int A_21_A_11_inv_A_12_structure = product_structure(A_21_A_11_inv_structure, A_12_structure);
+    remove_matrix(&A_21_A_11_inv);
 
     matrix_t S_22 = {};
-    create_matrix(split_point, split_point, &S_22);
-
     sub_matrix(&A_22, &A_21_A_11_inv_A_12, &S_22);
+    remove_matrix(&A_21_A_11_inv_A_12);
+    remove_matrix(&A_22);
+    // with a zero correction the Schur complement is A_22 itself
+    int S_22_structure = (A_21_A_11_inv_A_12_structure == ZERO_BLOCK) ? A_22_structure : GENERAL_BLOCK;
 
     matrix_t S_22_inv = {};
-    create_matrix(split_point, split_point, &S_22_inv);
-    inverse(&S_22, &S_22_inv);
+    create_matrix(n2, n2, &S_22_inv);
+    int S_22_status = inverse(&S_22, &S_22_inv);
+    remove_matrix(&S_22);
+    if (S_22_status != OK || norm_inf(&S_22_inv) * norm_inf(A) > GROWTH_LIMIT)
+    {
+      // bad Schur complement, invert this subproblem with the pivoted LU leaf
+      remove_matrix(&A_11);
+      remove_matrix(&A_12);
+      remove_matrix(&A_21);
+      remove_matrix(&A_11_inv);
+      remove_matrix(&S_22_inv);
+      return lu_inverse(A, inv_A);
+    }
+    int S_22_inv_structure = (S_22_structure == IDENTITY_BLOCK) ? IDENTITY_BLOCK : GENERAL_BLOCK;
 
     matrix_t A_12_S_22_inv = {};
-    create_matrix(split_point, split_point, &A_12_S_22_inv);
-    mult_matrix(&A_12, &S_22_inv, &A_12_S_22_inv);
+    mult_matrix_structured(&A_12, A_12_structure, &S_22_inv, S_22_inv_structure, &A_12_S_22_inv);
+    int A_12_S_22_inv_structure = product_structure(A_12_structure, S_22_inv_structure);
 
     matrix_t A_12_S_22_inv_A_21 = {};
-    create_matrix(split_point, split_point, &A_12_S_22_inv_A_21);
-
-    mult_matrix(&A_12_S_22_inv, &A_21, &A_12_S_22_inv_A_21);
+    mult_matrix_structured(&A_12_S_22_inv, A_12_S_22_inv_structure, &A_21, A_21_structure, &A_12_S_22_inv_A_21);
+    int A_12_S_22_inv_A_21_structure = product_structure(A_12_S_22_inv_structure, A_21_structure);
+    remove_matrix(&A_12_S_22_inv);
 
     matrix_t A_12_S_22_inv_A_21_A_11_inv = {};
-    create_matrix(split_point, split_point, &A_12_S_22_inv_A_21_A_11_inv);
+    mult_matrix_structured(&A_12_S_22_inv_A_21, A_12_S_22_inv_A_21_structure, &A_11_inv, A_11_inv_structure,
+                           &A_12_S_22_inv_A_21_A_11_inv);
+    int A_12_S_22_inv_A_21_A_11_inv_structure = product_structure(A_12_S_22_inv_A_21_structure, A_11_inv_structure);
+    remove_matrix(&A_12_S_22_inv_A_21);
 
-    mult_matrix(&A_12_S_22_inv_A_21, &A_11_inv, &A_12_S_22_inv_A_21_A_11_inv);
+    matrix_t id = {};
+    get_identity_matrix(n1, &id);
 
     matrix_t A_12_S_22_inv_A_21_A_11_inv_id = {};
-    create_matrix(split_point, split_point, &A_12_S_22_inv_A_21_A_11_inv_id);
-
     sum_matrix(&A_12_S_22_inv_A_21_A_11_inv, &id, &A_12_S_22_inv_A_21_A_11_inv_id);
+    int A_12_S_22_inv_A_21_A_11_inv_id_structure =
+        (A_12_S_22_inv_A_21_A_11_inv_structure == ZERO_BLOCK) ? IDENTITY_BLOCK : GENERAL_BLOCK;
+    remove_matrix(&A_12_S_22_inv_A_21_A_11_inv);
+    remove_matrix(&id);
 
     matrix_t B_11 = {};
-    create_matrix(split_point, split_point, &B_11);
-    mult_matrix(&A_11_inv, &A_12_S_22_inv_A_21_A_11_inv_id, &B_11);
+    mult_matrix_structured(&A_11_inv, A_11_inv_structure, &A_12_S_22_inv_A_21_A_11_inv_id,
+                           A_12_S_22_inv_A_21_A_11_inv_id_structure, &B_11);
+    remove_matrix(&A_12_S_22_inv_A_21_A_11_inv_id);
 
     matrix_t A_11_inv_A_12 = {};
-    create_matrix(split_point, split_point, &A_11_inv_A_12);
-    mult_matrix(&A_11_inv, &A_12, &A_11_inv_A_12);
+    mult_matrix_structured(&A_11_inv, A_11_inv_structure, &A_12, A_12_structure, &A_11_inv_A_12);
+    int A_11_inv_A_12_structure = product_structure(A_11_inv_structure, A_12_structure);
     matrix_t B_12d = {};
-    create_matrix(split_point, split_point, &B_12d);
-    mult_matrix(&A_11_inv_A_12, &S_22_inv, &B_12d);
+    mult_matrix_structured(&A_11_inv_A_12, A_11_inv_A_12_structure, &S_22_inv, S_22_inv_structure, &B_12d);
+    remove_matrix(&A_11_inv_A_12);
 
     matrix_t B_12 = {};
-    create_matrix(split_point, split_point, &B_12);
     mult_number(&B_12d, -1, &B_12);
+    remove_matrix(&B_12d);
 
     matrix_t S_22_inv_A_21 = {};
-    create_matrix(split_point, split_point, &S_22_inv_A_21);
-    mult_matrix(&S_22_inv, &A_21, &S_22_inv_A_21);
+    mult_matrix_structured(&S_22_inv, S_22_inv_structure, &A_21, A_21_structure, &S_22_inv_A_21);
+    int S_22_inv_A_21_structure = product_structure(S_22_inv_structure, A_21_structure);
 
     matrix_t B_21d = {};
-    create_matrix(split_point, split_point, &B_21d);
-    mult_matrix(&S_22_inv_A_21, &A_11_inv, &B_21d);
+    mult_matrix_structured(&S_22_inv_A_21, S_22_inv_A_21_structure, &A_11_inv, A_11_inv_structure, &B_21d);
+    remove_matrix(&S_22_inv_A_21);
 
     matrix_t B_21 = {};
-    create_matrix(split_point, split_point, &B_21);
     mult_number(&B_21d, -1, &B_21);
-    // B_21.matrix[0][0] *= -1;
-
-    matrix_t B_22 = {};
-    create_matrix(split_point, split_point, &B_22);
-
-    for (int i = 0; i < split_point; i++)
-    {
-      for (int j = 0; j < split_point; j++)
-      {
-        B_22.matrix[i][j] = S_22_inv.matrix[i][j];
-      }
-    }
-    merge_matrices(&B_11, &B_12, &B_21, &B_22, inv_A);
+    remove_matrix(&B_21d);
+
+    // the bottom right block of the inverse is S_22^-1 itself
+    merge_matrices(&B_11, &B_12, &B_21, &S_22_inv, inv_A);
+
+    remove_matrix(&A_11);
+    remove_matrix(&A_12);
+    remove_matrix(&A_21);
+    remove_matrix(&A_11_inv);
+    remove_matrix(&S_22_inv);
+    remove_matrix(&B_11);
+    remove_matrix(&B_12);
+    remove_matrix(&B_21);
   }
+
+  return OK;
 }
 // Function that request user to input Matrix elements
 void RequestInput(const char *name, matrix_t *A, int n)
@@ -601,119 +1037,57 @@ int main()
   printf("\nChoose Matrix Dimension for the square matrix: ");
   scanf("%d", &n);
   printf("\n");
-  int next_size = pow(2, ceil(log(n) / log(2)));
-  int adjusted_size = next_size - n;
 
-  if (adjusted_size == 0)
+  // Error condition 1
+  if (n <= 0)
   {
-
-    create_matrix(n, n, &A);
-
-    // Note: You can either enter the matrix input manually, or choose to fill the matrices automatically. But make sure to comment "RequestInput" function calls, and to uncomment the alternative random input option.
-    RequestInput("A", &A, n);
-    // This is an alternative random input option, but make sure to comment "RequestInput" function calls.
-    /*for (int i = 0; i < n; i++)
-    {
-      for (int j = 0; j < n; j++)
-      {
-        A.matrix[i][j] = randomFloat();
-      }
-    }*/
-
-    printf("Generate elements...\n");
-    printf("\n");
-    printf("Matrix A:\n");
-    print_matrix(&A);
-    printf("\n");
-    matrix_t inv_A = {};
-    create_matrix(n, n, &inv_A);
-
-    start_time = clock();
-    // Perform inversion
-    inverse(&A, &inv_A);
-    end_time = clock();
-
-    printf("Matrix A inverse: \n");
-    print_matrix(&inv_A);
-
-    printf("\n");
-    printf("Time taken for Strassen's Algorithm: %.6f seconds\n", (double)(end_time - start_time) / CLOCKS_PER_SEC);
-
-    matrix_t A_inv_A = {};
-
-    create_matrix(n, n, &A_inv_A);
-
-    mult_matrix(&A, &inv_A, &A_inv_A);
+    printf("Matrix Size can only be larger than zero, the program will exit...");
+    exit(1);
   }
-  else
-  {
-
-    create_matrix(next_size, next_size, &A);
-
-    // Note: You can either enter the matrix input manually, or choose to fill the matrices automatically. But make sure to comment "RequestInput" function calls, and to uncomment the alternative random input option.
-    RequestInput("A", &A, n);
 
-    // This is an alternative random input option, but make sure to comment "RequestInput" function calls.
-    /*for (int i = 0; i < n; i++) {
-      for (int j = 0; j < n; j++)
-      {
-        A.matrix[i][j] = randomFloat();
-      }
-    }*/
+  // no padding, inverse() splits odd sizes unevenly
+  create_matrix(n, n, &A);
 
-    printf("Generate elements and Padding Elements...\n");
-
-    // padding
-    for (int i = n; i < next_size; i++)
+  // Note: You can either enter the matrix input manually, or choose to fill the matrices automatically. But make sure to comment "RequestInput" function calls, and to uncomment the alternative random input option.
+  RequestInput("A", &A, n);
+  // This is an alternative random input option, but make sure to comment "RequestInput" function calls.
+  /*for (int i = 0; i < n; i++)
+  {
+    for (int j = 0; j < n; j++)
     {
-      for (int j = n; j < next_size; j++)
-      {
-        if (i == j)
-        {
-          A.matrix[i][j] = 1;
-        }
-        else
-        {
-          A.matrix[i][j] = 0;
-        }
-      }
+      A.matrix[i][j] = randomFloat();
     }
+  }*/
 
-    printf("Matrix A:\n");
-    print_matrix(&A);
-    printf("\n");
-    matrix_t inv_A = {};
-    create_matrix(next_size, next_size, &inv_A);
-
-    start_time = clock();
-    inverse(&A, &inv_A);
-    end_time = clock();
+  printf("Generate elements...\n");
+  printf("\n");
+  printf("Matrix A:\n");
+  print_matrix(&A);
+  printf("\n");
+  matrix_t inv_A = {};
+  create_matrix(n, n, &inv_A);
 
-    matrix_t orig_A = {};
-    create_matrix(n, n, &orig_A);
+  start_time = clock();
+  // Perform inversion
+  int error_code = inverse(&A, &inv_A);
+  end_time = clock();
 
-    matrix_t orig_inv_A = {};
-    create_matrix(n, n, &orig_inv_A);
+  // Error condition 2
+  if (error_code != OK)
+  {
+    printf("Matrix is singular, the program will exit...");
+    exit(1);
+  }
 
-    // store original matrix
-    for (int i = 0; i < n; i++)
-    {
-      for (int j = 0; j < n; j++)
-      {
-        orig_A.matrix[i][j] = A.matrix[i][j];
-        orig_inv_A.matrix[i][j] = inv_A.matrix[i][j];
-      }
-    }
+  printf("Matrix A inverse: \n");
+  print_matrix(&inv_A);
 
-    printf("Matrix A inverse:\n");
-    print_matrix(&orig_inv_A);
+  printf("\n");
+  printf("Time taken for Strassen's Inversion using Naive multiplication Algorithm: %.6f seconds\n", (double)(end_time - start_time) / CLOCKS_PER_SEC);
 
-    printf("\n");
-    printf("Time taken for Strassen's Inversion using Naive multiplication Algorithm: %.6f seconds\n", (double)(end_time - start_time) / CLOCKS_PER_SEC);
+  matrix_t A_inv_A = {};
 
-    matrix_t A_inv_A = {};
+  create_matrix(n, n, &A_inv_A);
 
-    create_matrix(n, n, &A_inv_A);
-    mult_matrix(&orig_A, &orig_inv_A, &A_inv_A);
-  }
+  mult_matrix(&A, &inv_A, &A_inv_A);
 }
\ No newline at end of file
@@ -8,47 +8,318 @@ Tan Viet Nguyen - 21400381
 */
 #include <stdio.h>
 #include <stdlib.h>
-#include <stdbool.h>
+#include <math.h>
+#include <float.h>
 #include <time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
-// allocate memory for matrices
-double **allocate_matrix(int size)
+// Products and inversions at or below this size run in the task that reaches them, no new tasks are spawned
+#define TASK_CUTOFF 256
+
+// Blocks up to this size are inverted by the unrolled fixed-size kernels
+#define SMALL_INVERSE_SIZE 8
+
+// A block whose inverse is this much larger than the matrix it belongs to is treated as a bad pivot:
+// ||a^-1|| * ||A|| above the limit sends the subproblem to the pivoted LU leaf
+#define GROWTH_LIMIT 1e10
+
+// Newton-Schulz stops once ||I - A * X|| is below the tolerance, or when it stops decreasing (rounding floor)
+#define NEWTON_SCHULZ_TOLERANCE 1e-14
+#define NEWTON_SCHULZ_MAX_ITERATIONS 100
+
+enum ERROR_CODES
 {
-    double **matrix = (double **)malloc(size * sizeof(double *));
-    for (int i = 0; i < size; i++)
+    OK,
+    INCORRECT_MATRIX,
+    CALCULATION_ERROR
+};
+
+// allocate memory for a rows x columns matrix
+double **allocate_matrix(int rows, int columns)
+{
+    double **matrix = (double **)malloc(rows * sizeof(double *));
+    for (int i = 0; i < rows; i++)
     {
-        matrix[i] = (double *)malloc(size * sizeof(double));
+        matrix[i] = (double *)malloc(columns * sizeof(double));
     }
     return matrix;
 }
 
 // free allocated memory of matrices
-void free_matrix(double **matrix, int size)
+void free_matrix(double **matrix, int rows)
 {
-    for (int i = 0; i < size; i++)
+    for (int i = 0; i < rows; i++)
     {
         free(matrix[i]);
     }
     free(matrix);
 }
 
-// Invert a 1x1 matrix
-void invert_1x1(double **A, double **A_inv)
+// Small fixed-size inverses on flat row-major arrays (A[i * n + j]), the base case of the recursive inversion
+// and usable directly when many small matrices have to be inverted
+// The determinant comes back as log|det(A)| and its sign, built up pivot by pivot (or from the scaled closed form),
+// so a block of very large or very small entries cannot overflow or underflow it
+// CALCULATION_ERROR when A is singular to working precision (a pivot or det lost in the rounding of its own terms)
+// or when its inverse has a non-finite entry; strassen_inversion then retries the block with lu_inversion
+// Each program in this folder is one source file built on its own, so the naive-multiplication inversion carries
+// its own copy of these kernels (only the indentation differs); a fix here belongs in both files
+
+// largest |a_ij| of a flat block
+static inline double max_abs(const double *A, const int count)
+{
+    double scale = 0.0;
+    for (int i = 0; i < count; i++)
+    {
+        if (fabs(A[i]) > scale)
+        {
+            scale = fabs(A[i]);
+        }
+    }
+    return scale;
+}
+
+// 1 when every entry of a flat block is finite
+static inline int all_finite(const double *A, const int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (!isfinite(A[i]))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// 2x2 closed form on B = A / s with s = max|a_ij|: A^-1 = adj(B) / (det(B) * s)
+// Scaling first keeps det(B) and the adjugate in range for blocks such as 1e-160 * I or 1e160 * I
+int invert_2x2(const double *A, double *A_inv, double *log_abs_det, int *det_sign)
 {
-    if (A[0][0] == 0)
+    double s = max_abs(A, 4);
+    if (s == 0.0 || !isfinite(s))
+    {
+        return CALCULATION_ERROR;
+    }
+    double B[4];
+    for (int i = 0; i < 4; i++)
+    {
+        B[i] = A[i] / s;
+    }
+
+    double d = B[0] * B[3] - B[1] * B[2];
+    if (fabs(d) <= 2 * DBL_EPSILON * (fabs(B[0] * B[3]) + fabs(B[1] * B[2])))
+    {
+        return CALCULATION_ERROR;
+    }
+    double r = 1.0 / d;
+    A_inv[0] = B[3] * r / s;
+    A_inv[1] = -B[1] * r / s;
+    A_inv[2] = -B[2] * r / s;
+    A_inv[3] = B[0] * r / s;
+    *log_abs_det = log(fabs(d)) + 2 * log(s);
+    *det_sign = (d > 0) ? 1 : -1;
+    return all_finite(A_inv, 4) ? OK : CALCULATION_ERROR;
+}
+
+// 3x3 closed form on B = A / s: cofactors of the first row give det(B), the adjugate is the transposed
+// cofactor matrix, and A^-1 = adj(B) / (det(B) * s)
+int invert_3x3(const double *A, double *A_inv, double *log_abs_det, int *det_sign)
+{
+    double s = max_abs(A, 9);
+    if (s == 0.0 || !isfinite(s))
+    {
+        return CALCULATION_ERROR;
+    }
+    double B[9];
+    for (int i = 0; i < 9; i++)
+    {
+        B[i] = A[i] / s;
+    }
+
+    double c00 = B[4] * B[8] - B[5] * B[7];
+    double c01 = B[5] * B[6] - B[3] * B[8];
+    double c02 = B[3] * B[7] - B[4] * B[6];
+    double d = B[0] * c00 + B[1] * c01 + B[2] * c02;
+    if (fabs(d) <= 4 * DBL_EPSILON * (fabs(B[0] * c00) + fabs(B[1] * c01) + fabs(B[2] * c02)))
     {
-        fprintf(stderr, "Matrix is singular and cannot be inverted.\n");
-        exit(EXIT_FAILURE);
+        return CALCULATION_ERROR;
+    }
+    double r = 1.0 / d;
+    A_inv[0] = c00 * r / s;
+    A_inv[1] = (B[2] * B[7] - B[1] * B[8]) * r / s;
+    A_inv[2] = (B[1] * B[5] - B[2] * B[4]) * r / s;
+    A_inv[3] = c01 * r / s;
+    A_inv[4] = (B[0] * B[8] - B[2] * B[6]) * r / s;
+    A_inv[5] = (B[2] * B[3] - B[0] * B[5]) * r / s;
+    A_inv[6] = c02 * r / s;
+    A_inv[7] = (B[1] * B[6] - B[0] * B[7]) * r / s;
+    A_inv[8] = (B[0] * B[4] - B[1] * B[3]) * r / s;
+    *log_abs_det = log(fabs(d)) + 3 * log(s);
+    *det_sign = (d > 0) ? 1 : -1;
+    return all_finite(A_inv, 9) ? OK : CALCULATION_ERROR;
+}
+
+// Gauss-Jordan with partial pivoting on [A | I] held in local arrays
+// Every caller passes a constant N, so after inlining all loop bounds are known and the compiler unrolls
+// and vectorizes the row updates; rows are swapped by index through perm instead of moving data
+// A pivot is lost when it is below N * eps times the largest original entry of its own column, so a badly
+// scaled but invertible matrix such as diag(1, 1, 1, 1e-20) is not mistaken for a singular one
+static inline int gauss_jordan_fixed(const double *A, double *A_inv, double *log_abs_det, int *det_sign, const int N)
+{
+    double a[SMALL_INVERSE_SIZE][SMALL_INVERSE_SIZE];
+    double x[SMALL_INVERSE_SIZE][SMALL_INVERSE_SIZE];
+    int perm[SMALL_INVERSE_SIZE];
+    double log_det = 0.0;
+    int sign = 1;
+    double scale[SMALL_INVERSE_SIZE];
+
+    for (int j = 0; j < N; j++)
+    {
+        scale[j] = 0.0;
+    }
+    for (int i = 0; i < N; i++)
+    {
+        perm[i] = i;
+        for (int j = 0; j < N; j++)
+        {
+            a[i][j] = A[i * N + j];
+            x[i][j] = (i == j) ? 1.0 : 0.0;
+            if (fabs(a[i][j]) > scale[j])
+            {
+                scale[j] = fabs(a[i][j]);
+            }
+        }
+    }
+
+    for (int k = 0; k < N; k++)
+    {
+        int pivot = k;
+        for (int i = k + 1; i < N; i++)
+        {
+            if (fabs(a[perm[i]][k]) > fabs(a[perm[pivot]][k]))
+            {
+                pivot = i;
+            }
+        }
+        if (pivot != k)
+        {
+            int index = perm[k];
+            perm[k] = perm[pivot];
+            perm[pivot] = index;
+            sign = -sign;
+        }
+        int p = perm[k];
+        double pivot_value = a[p][k];
+        if (fabs(pivot_value) <= N * DBL_EPSILON * scale[k])
+        {
+            return CALCULATION_ERROR;
+        }
+        log_det += log(fabs(pivot_value));
+        if (pivot_value < 0)
+        {
+            sign = -sign;
+        }
+
+        double r = 1.0 / pivot_value;
+        for (int j = 0; j < N; j++)
+        {
+            a[p][j] *= r;
+            x[p][j] *= r;
+        }
+        for (int i = 0; i < N; i++)
+        {
+            if (i == p)
+            {
+                continue;
+            }
+            double factor = a[i][k];
+            for (int j = 0; j < N; j++)
+            {
+                a[i][j] -= factor * a[p][j];
+                x[i][j] -= factor * x[p][j];
+            }
+        }
+    }
+
+    // row k of the inverse sits in the row that was chosen as pivot k
+    for (int k = 0; k < N; k++)
+    {
+        for (int j = 0; j < N; j++)
+        {
+            A_inv[k * N + j] = x[perm[k]][j];
+        }
+    }
+    *log_abs_det = log_det;
+    *det_sign = sign;
+    return all_finite(A_inv, N * N) ? OK : CALCULATION_ERROR;
+}
+
+int invert_4x4(const double *A, double *A_inv, double *log_abs_det, int *det_sign)
+{
+    return gauss_jordan_fixed(A, A_inv, log_abs_det, det_sign, 4);
+}
+
+int invert_5x5(const double *A, double *A_inv, double *log_abs_det, int *det_sign)
+{
+    return gauss_jordan_fixed(A, A_inv, log_abs_det, det_sign, 5);
+}
+
+int invert_6x6(const double *A, double *A_inv, double *log_abs_det, int *det_sign)
+{
+    return gauss_jordan_fixed(A, A_inv, log_abs_det, det_sign, 6);
+}
+
+int invert_7x7(const double *A, double *A_inv, double *log_abs_det, int *det_sign)
+{
+    return gauss_jordan_fixed(A, A_inv, log_abs_det, det_sign, 7);
+}
+
+int invert_8x8(const double *A, double *A_inv, double *log_abs_det, int *det_sign)
+{
+    return gauss_jordan_fixed(A, A_inv, log_abs_det, det_sign, 8);
+}
+
+// Dispatch on n = 1 .. SMALL_INVERSE_SIZE
+int invert_small(const double *A, double *A_inv, int n, double *log_abs_det, int *det_sign)
+{
+    switch (n)
+    {
+    case 1:
+        if (A[0] == 0.0)
+        {
+            return CALCULATION_ERROR;
+        }
+        A_inv[0] = 1.0 / A[0];
+        *log_abs_det = log(fabs(A[0]));
+        *det_sign = (A[0] > 0) ? 1 : -1;
+        return all_finite(A_inv, 1) ? OK : CALCULATION_ERROR;
+    case 2:
+        return invert_2x2(A, A_inv, log_abs_det, det_sign);
+    case 3:
+        return invert_3x3(A, A_inv, log_abs_det, det_sign);
+    case 4:
+        return invert_4x4(A, A_inv, log_abs_det, det_sign);
+    case 5:
+        return invert_5x5(A, A_inv, log_abs_det, det_sign);
+    case 6:
+        return invert_6x6(A, A_inv, log_abs_det, det_sign);
+    case 7:
+        return invert_7x7(A, A_inv, log_abs_det, det_sign);
+    case 8:
+        return invert_8x8(A, A_inv, log_abs_det, det_sign);
+    default:
+        return INCORRECT_MATRIX;
     }
-    A_inv[0][0] = 1.0 / A[0][0];
 }
 
 // subtraction of two matrices
-void subtract_matrix(double **A, double **B, double **C, int size)
+void subtract_matrix(double **A, double **B, double **C, int rows, int columns)
 {
-    for (int i = 0; i < size; i++)
+    for (int i = 0; i < rows; i++)
     {
-        for (int j = 0; j < size; j++)
+        for (int j = 0; j < columns; j++)
         {
             C[i][j] = A[i][j] - B[i][j];
         }
@@ -56,36 +327,52 @@ void subtract_matrix(double **A, double **B, double **C, int size)
 }
 
 // addition of two matrices
-void add_matrix(double **A, double **B, double **C, int size)
+void add_matrix(double **A, double **B, double **C, int rows, int columns)
 {
-    for (int i = 0; i < size; i++)
+    for (int i = 0; i < rows; i++)
     {
-        for (int j = 0; j < size; j++)
+        for (int j = 0; j < columns; j++)
         {
             C[i][j] = A[i][j] + B[i][j];
         }
     }
 }
 
-bool is_power_of_two(int n)
-{
-    return (n > 0) && ((n & (n - 1)) == 0);
-}
-void nbasecase(double **A, double **B, double **result_matrix, int size)
+// R = M * N with plain loops, M is m x k and N is k x n
+void nbasecase(double **M, double **N, double **R, int m, int k, int n)
 {
-    for (int i = 0; i < size; i++)
+    for (int i = 0; i < m; i++)
     {
-        for (int j = 0; j < size; j++)
+        for (int j = 0; j < n; j++)
         {
-            result_matrix[i][j] = 0.0;
-            for (int k = 0; k < size; k++)
+            R[i][j] = 0.0;
+            for (int p = 0; p < k; p++)
             {
-                result_matrix[i][j] += A[i][k] * B[k][j];
+                R[i][j] += M[i][p] * N[p][j];
             }
         }
     }
 }
 
+// infinity norm of a matrix (largest absolute row sum)
+double norm_inf(double **A, int rows, int columns)
+{
+    double norm = 0.0;
+    for (int i = 0; i < rows; i++)
+    {
+        double sum = 0.0;
+        for (int j = 0; j < columns; j++)
+        {
+            sum += fabs(A[i][j]);
+        }
+        if (sum > norm)
+        {
+            norm = sum;
+        }
+    }
+    return norm;
+}
+
 // Function to print a matrix
 void printMatrix(const char *name, double **matrix, int n)
 {
@@ -100,260 +387,629 @@ void printMatrix(const char *name, double **matrix, int n)
     }
 }
 
-// Strassen's algorithm:
-void strassen_mult(double **M, double **N, double **R, int size)
+// Strassen's algorithm: R = M * N, M is m x k and N is k x n
+// The seven products run on the even part of every dimension, an odd last row / column / inner index is peeled off
+// and handled with plain loops, so no dimension has to be a power of two
+void strassen_mult(double **M, double **N, double **R, int m, int k, int n)
 {
 
-    if (size <= 64)
+    if (m <= 64 || k <= 64 || n <= 64)
     {
-        nbasecase(M, N, R, size);
+        nbasecase(M, N, R, m, k, n);
         return;
     }
 
-    int newSize = size / 2;
+    int m2 = m / 2, k2 = k / 2, n2 = n / 2;
 
     // submatrices allocation
-    double **a = allocate_matrix(newSize);
-    double **b = allocate_matrix(newSize);
-    double **c = allocate_matrix(newSize);
-    double **d = allocate_matrix(newSize);
-    double **x = allocate_matrix(newSize);
-    double **y = allocate_matrix(newSize);
-    double **z = allocate_matrix(newSize);
-    double **t = allocate_matrix(newSize);
-    double **q1 = allocate_matrix(newSize);
-    double **q2 = allocate_matrix(newSize);
-    double **q3 = allocate_matrix(newSize);
-    double **q4 = allocate_matrix(newSize);
-    double **q5 = allocate_matrix(newSize);
-    double **q6 = allocate_matrix(newSize);
-    double **q7 = allocate_matrix(newSize);
-    double **r11 = allocate_matrix(newSize);
-    double **r12 = allocate_matrix(newSize);
-    double **r21 = allocate_matrix(newSize);
-    double **r22 = allocate_matrix(newSize);
-
-    double **temp1 = allocate_matrix(newSize);
-    double **temp2 = allocate_matrix(newSize);
+    double **a = allocate_matrix(m2, k2);
+    double **b = allocate_matrix(m2, k2);
+    double **c = allocate_matrix(m2, k2);
+    double **d = allocate_matrix(m2, k2);
+    double **x = allocate_matrix(k2, n2);
+    double **y = allocate_matrix(k2, n2);
+    double **z = allocate_matrix(k2, n2);
+    double **t = allocate_matrix(k2, n2);
+    double **q1 = allocate_matrix(m2, n2);
+    double **q2 = allocate_matrix(m2, n2);
+    double **q3 = allocate_matrix(m2, n2);
+    double **q4 = allocate_matrix(m2, n2);
+    double **q5 = allocate_matrix(m2, n2);
+    double **q6 = allocate_matrix(m2, n2);
+    double **q7 = allocate_matrix(m2, n2);
+
+    // one operand buffer per product, so the seven products are independent and can run as tasks
+    double **l3 = allocate_matrix(m2, k2);
+    double **l4 = allocate_matrix(m2, k2);
+    double **l5 = allocate_matrix(m2, k2);
+    double **l6 = allocate_matrix(m2, k2);
+    double **l7 = allocate_matrix(m2, k2);
+    double **r1 = allocate_matrix(k2, n2);
+    double **r2 = allocate_matrix(k2, n2);
+    double **r3 = allocate_matrix(k2, n2);
+    double **r4 = allocate_matrix(k2, n2);
+    double **r6 = allocate_matrix(k2, n2);
 
     // M and N submatrices (Blocks)
-    for (int i = 0; i < newSize; i++)
+    for (int i = 0; i < m2; i++)
+    {
+        for (int j = 0; j < k2; j++)
+        {
+            a[i][j] = M[i][j];           // M11
+            b[i][j] = M[i][j + k2];      // M12
+            c[i][j] = M[i + m2][j];      // M21
+            d[i][j] = M[i + m2][j + k2]; // M22
+        }
+    }
+    for (int i = 0; i < k2; i++)
     {
-        for (int j = 0; j < newSize; j++)
+        for (int j = 0; j < n2; j++)
         {
-            a[i][j] = M[i][j];                     // M11
-            b[i][j] = M[i][j + newSize];           // M12
-            c[i][j] = M[i + newSize][j];           // M21
-            d[i][j] = M[i + newSize][j + newSize]; // M22
-            x[i][j] = N[i][j];                     // N11
-            y[i][j] = N[i][j + newSize];           // N12
-            z[i][j] = N[i + newSize][j];           // N21
-            t[i][j] = N[i + newSize][j + newSize]; // N22
+            x[i][j] = N[i][j];           // N11
+            y[i][j] = N[i][j + n2];      // N12
+            z[i][j] = N[i + k2][j];      // N21
+            t[i][j] = N[i + k2][j + n2]; // N22
         }
     }
 
+    // operands of the seven products
+    add_matrix(x, z, r1, k2, n2);      // x + z
+    add_matrix(y, t, r2, k2, n2);      // y + t
+    subtract_matrix(d, a, l3, m2, k2); // d - a
+    subtract_matrix(z, y, r3, k2, n2); // z - y
+    subtract_matrix(b, d, l4, m2, k2); // b - d
+    add_matrix(z, t, r4, k2, n2);      // z + t
+    subtract_matrix(b, a, l5, m2, k2); // b - a
+    subtract_matrix(c, a, l6, m2, k2); // c - a
+    add_matrix(x, y, r6, k2, n2);      // x + y
+    subtract_matrix(c, d, l7, m2, k2); // c - d
+
     // q1 = a * (x + z)
-    add_matrix(x, z, temp2, newSize);
-    strassen_mult(a, temp2, q1, newSize); // recursive call
+#pragma omp task if (m > TASK_CUTOFF && n > TASK_CUTOFF)
+    strassen_mult(a, r1, q1, m2, k2, n2); // recursive call
 
     // q2 = d * (y + t)
-    add_matrix(y, t, temp2, newSize);
-    strassen_mult(d, temp2, q2, newSize); // recursive call
+#pragma omp task if (m > TASK_CUTOFF && n > TASK_CUTOFF)
+    strassen_mult(d, r2, q2, m2, k2, n2); // recursive call
 
     // q3 = (d - a) * (z - y)
-    subtract_matrix(d, a, temp1, newSize);
-    subtract_matrix(z, y, temp2, newSize);
-    strassen_mult(temp1, temp2, q3, newSize); // recursive call
+#pragma omp task if (m > TASK_CUTOFF && n > TASK_CUTOFF)
+    strassen_mult(l3, r3, q3, m2, k2, n2); // recursive call
 
     // q4 = (b - d) * (z + t)
-    subtract_matrix(b, d, temp1, newSize);
-    add_matrix(z, t, temp2, newSize);
-    strassen_mult(temp1, temp2, q4, newSize); // recursive call
+#pragma omp task if (m > TASK_CUTOFF && n > TASK_CUTOFF)
+    strassen_mult(l4, r4, q4, m2, k2, n2); // recursive call
 
     // q5 = (b - a) * z
-    subtract_matrix(b, a, temp1, newSize);
-    strassen_mult(temp1, z, q5, newSize); // recursive call
+#pragma omp task if (m > TASK_CUTOFF && n > TASK_CUTOFF)
+    strassen_mult(l5, z, q5, m2, k2, n2); // recursive call
 
     // q6 = (c - a) * (x + y)
-    subtract_matrix(c, a, temp1, newSize);
-    add_matrix(x, y, temp2, newSize);
-    strassen_mult(temp1, temp2, q6, newSize); // recursive call
+#pragma omp task if (m > TASK_CUTOFF && n > TASK_CUTOFF)
+    strassen_mult(l6, r6, q6, m2, k2, n2); // recursive call
 
     // q7 = (c - d) * y
-    subtract_matrix(c, d, temp1, newSize);
-    strassen_mult(temp1, y, q7, newSize); // recursive call
+    strassen_mult(l7, y, q7, m2, k2, n2); // recursive call
+
+#pragma omp taskwait
 
-    // r11 = q1 + q5
-    add_matrix(q1, q5, r11, newSize);
+    // result matrix R (even part): r11 = q1 + q5, r12 = q2 + q3 + q4 - q5, r21 = q1 + q3 + q6 - q7, r22 = q2 + q7
+    for (int i = 0; i < m2; i++)
+    {
+        for (int j = 0; j < n2; j++)
+        {
+            R[i][j] = q1[i][j] + q5[i][j];
+            R[i][j + n2] = q2[i][j] + q3[i][j] + q4[i][j] - q5[i][j];
+            R[i + m2][j] = q1[i][j] + q3[i][j] + q6[i][j] - q7[i][j];
+            R[i + m2][j + n2] = q2[i][j] + q7[i][j];
+        }
+    }
+
+    // Peeling: an odd inner dimension adds a rank-1 term to the even part
+    if (k % 2)
+    {
+        for (int i = 0; i < 2 * m2; i++)
+        {
+            double factor = M[i][k - 1];
+            for (int j = 0; j < 2 * n2; j++)
+            {
+                R[i][j] += factor * N[k - 1][j];
+            }
+        }
+    }
+    // Odd last column, then odd last row
+    if (n % 2)
+    {
+        for (int i = 0; i < m; i++)
+        {
+            double sum = 0.0;
+            for (int p = 0; p < k; p++)
+            {
+                sum += M[i][p] * N[p][n - 1];
+            }
+            R[i][n - 1] = sum;
+        }
+    }
+    if (m % 2)
+    {
+        for (int j = 0; j < 2 * n2; j++)
+        {
+            R[m - 1][j] = 0.0;
+        }
+        for (int p = 0; p < k; p++)
+        {
+            double factor = M[m - 1][p];
+            for (int j = 0; j < 2 * n2; j++)
+            {
+                R[m - 1][j] += factor * N[p][j];
+            }
+        }
+    }
+
+    //  free allocated memory
+    free_matrix(a, m2);
+    free_matrix(b, m2);
+    free_matrix(c, m2);
+    free_matrix(d, m2);
+    free_matrix(x, k2);
+    free_matrix(y, k2);
+    free_matrix(z, k2);
+    free_matrix(t, k2);
+    free_matrix(q1, m2);
+    free_matrix(q2, m2);
+    free_matrix(q3, m2);
+    free_matrix(q4, m2);
+    free_matrix(q5, m2);
+    free_matrix(q6, m2);
+    free_matrix(q7, m2);
+    free_matrix(l3, m2);
+    free_matrix(l4, m2);
+    free_matrix(l5, m2);
+    free_matrix(l6, m2);
+    free_matrix(l7, m2);
+    free_matrix(r1, k2);
+    free_matrix(r2, k2);
+    free_matrix(r3, k2);
+    free_matrix(r4, k2);
+    free_matrix(r6, k2);
+}
 
-    // r12 = q2 + q3 + q4 - q5
-    add_matrix(q2, q3, temp1, newSize);
-    add_matrix(temp1, q4, temp2, newSize);
-    subtract_matrix(temp2, q5, r12, newSize);
+// Pivoted LU leaf: A_inv = A^-1 from P * A = L * U, one column of the identity at a time
+// Used on a subproblem of the recursion whose leading block or Schur complement is singular or ill-conditioned
+int lu_inversion(double **A, double **A_inv, int size, double *log_abs_det, int *det_sign)
+{
+    double **LU = allocate_matrix(size, size);
+    int *perm = (int *)malloc(size * sizeof(int));
+    double *column = (double *)malloc(size * sizeof(double));
+    double log_det = 0.0;
+    int sign = 1;
+    int status = OK;
 
-    // r21 = q1 + q3 + q6 - q7
-    add_matrix(q1, q3, temp1, newSize);
-    add_matrix(temp1, q6, temp2, newSize);
-    subtract_matrix(temp2, q7, r21, newSize);
+    for (int i = 0; i < size; i++)
+    {
+        for (int j = 0; j < size; j++)
+        {
+            LU[i][j] = A[i][j];
+        }
+        perm[i] = i;
+    }
 
-    // r22 = q2 + q7
-    add_matrix(q2, q7, r22, newSize);
+    // P * A = L * U with partial pivoting, row swaps exchange row pointers
+    for (int k = 0; k < size && status == OK; k++)
+    {
+        int pivot = k;
+        for (int i = k + 1; i < size; i++)
+        {
+            if (fabs(LU[i][k]) > fabs(LU[pivot][k]))
+            {
+                pivot = i;
+            }
+        }
+        if (LU[pivot][k] == 0.0)
+        {
+            status = CALCULATION_ERROR;
+            break;
+        }
+        if (pivot != k)
+        {
+            double *row = LU[k];
+            LU[k] = LU[pivot];
+            LU[pivot] = row;
+            int index = perm[k];
+            perm[k] = perm[pivot];
+            perm[pivot] = index;
+            sign = -sign;
+        }
+        log_det += log(fabs(LU[k][k]));
+        if (LU[k][k] < 0)
+        {
+            sign = -sign;
+        }
+        for (int i = k + 1; i < size; i++)
+        {
+            LU[i][k] /= LU[k][k];
+            for (int j = k + 1; j < size; j++)
+            {
+                LU[i][j] -= LU[i][k] * LU[k][j];
+            }
+        }
+    }
 
-    // result matrix R
-    for (int i = 0; i < newSize; i++)
+    // column j of A^-1 solves L * U * x = P * e_j
+    for (int j = 0; j < size && status == OK; j++)
     {
-        for (int j = 0; j < newSize; j++)
+        for (int i = 0; i < size; i++)
         {
-            R[i][j] = r11[i][j];
-            R[i][j + newSize] = r12[i][j];
-            R[i + newSize][j] = r21[i][j];
-            R[i + newSize][j + newSize] = r22[i][j];
+            column[i] = (perm[i] == j) ? 1.0 : 0.0;
+            for (int p = 0; p < i; p++)
+            {
+                column[i] -= LU[i][p] * column[p];
+            }
+        }
+        for (int i = size - 1; i >= 0; i--)
+        {
+            for (int p = i + 1; p < size; p++)
+            {
+                column[i] -= LU[i][p] * column[p];
+            }
+            column[i] /= LU[i][i];
+            A_inv[i][j] = column[i];
         }
     }
-    //  free allocated memory
-    free_matrix(a, newSize);
-    free_matrix(b, newSize);
-    free_matrix(c, newSize);
-    free_matrix(d, newSize);
-    free_matrix(x, newSize);
-    free_matrix(y, newSize);
-    free_matrix(z, newSize);
-    free_matrix(t, newSize);
-    free_matrix(r11, newSize);
-    free_matrix(r12, newSize);
-    free_matrix(r21, newSize);
-    free_matrix(r22, newSize);
-    free_matrix(q1, newSize);
-    free_matrix(q2, newSize);
-    free_matrix(q3, newSize);
-    free_matrix(q4, newSize);
-    free_matrix(q5, newSize);
-    free_matrix(q6, newSize);
-    free_matrix(q7, newSize);
-    free_matrix(temp1, newSize);
-    free_matrix(temp2, newSize);
+
+    if (status == OK && log_abs_det != NULL)
+    {
+        *log_abs_det = log_det;
+        *det_sign = sign;
+    }
+
+    free_matrix(LU, size);
+    free(perm);
+    free(column);
+    return status;
 }
 
 // Strassen's Matrix Inversion
-void strassen_inversion(double **A, double **A_inv, int size)
+// The split is uneven for odd sizes: a is ceil(size / 2) square, d is floor(size / 2) square, b and c are rectangular,
+// so any size works without padding and the work tracks the real size
+// log|det(A)| and the sign of det(A) come for free from the blocks already formed:
+// det(A) = det(a) * det(z) with the Schur complement z = d - c * a^-1 * b, both inverted recursively
+// Accumulating in log space keeps large matrices from overflowing, pass NULL when they are not needed
+// A singular a or z, or one whose inverse grows past GROWTH_LIMIT, makes this level fall back to lu_inversion
+// for its own subproblem only; CALCULATION_ERROR is returned only when A itself is singular
+int strassen_inversion(double **A, double **A_inv, int size, double *log_abs_det, int *det_sign)
 {
-    if (size == 1)
+    if (size <= SMALL_INVERSE_SIZE)
     {
-        invert_1x1(A, A_inv);
-        return;
+        // Unrolled kernel on a flat copy of the block
+        double flat[SMALL_INVERSE_SIZE * SMALL_INVERSE_SIZE] = {0};
+        double flat_inv[SMALL_INVERSE_SIZE * SMALL_INVERSE_SIZE];
+        double block_log_det;
+        int block_sign;
+        for (int i = 0; i < size; i++)
+        {
+            for (int j = 0; j < size; j++)
+            {
+                flat[i * size + j] = A[i][j];
+            }
+        }
+        if (invert_small(flat, flat_inv, size, &block_log_det, &block_sign) != OK)
+        {
+            // the kernels give up on a pivot lost to rounding, the pivoted LU decides whether A is really singular
+            return lu_inversion(A, A_inv, size, log_abs_det, det_sign);
+        }
+        for (int i = 0; i < size; i++)
+        {
+            for (int j = 0; j < size; j++)
+            {
+                A_inv[i][j] = flat_inv[i * size + j];
+            }
+        }
+        if (log_abs_det != NULL)
+        {
+            *log_abs_det = block_log_det;
+            *det_sign = block_sign;
+        }
+        return OK;
     }
 
-    int newSize = size / 2;
+    int n1 = (size + 1) / 2;
+    int n2 = size - n1;
 
-    double **a = allocate_matrix(newSize);
-    double **b = allocate_matrix(newSize);
-    double **c = allocate_matrix(newSize);
-    double **d = allocate_matrix(newSize);
-    double **e = allocate_matrix(newSize);
-    double **z = allocate_matrix(newSize);
-    double **t = allocate_matrix(newSize);
-    double **x = allocate_matrix(newSize);
-    double **y = allocate_matrix(newSize);
+    double **a = allocate_matrix(n1, n1);
+    double **b = allocate_matrix(n1, n2);
+    double **c = allocate_matrix(n2, n1);
+    double **d = allocate_matrix(n2, n2);
+    double **e = allocate_matrix(n1, n1);
+    double **z = allocate_matrix(n2, n2);
+    double **t = allocate_matrix(n2, n2);
+    double **x = allocate_matrix(n1, n1);
+    double **y = allocate_matrix(n1, n2);
+    double **w = allocate_matrix(n2, n1);
 
-    double **temp1 = allocate_matrix(newSize);
-    double **temp2 = allocate_matrix(newSize);
+    double **eb = allocate_matrix(n1, n2);
+    double **ce = allocate_matrix(n2, n1);
+    double **temp1 = allocate_matrix(n2, n2);
+    double **temp2 = allocate_matrix(n1, n1);
 
     // Split A into submatrices
-    for (int i = 0; i < newSize; i++)
+    for (int i = 0; i < n1; i++)
     {
-        for (int j = 0; j < newSize; j++)
+        for (int j = 0; j < n1; j++)
         {
-            a[i][j] = A[i][j];                     // A11
-            b[i][j] = A[i][j + newSize];           // A12
-            c[i][j] = A[i + newSize][j];           // A21
-            d[i][j] = A[i + newSize][j + newSize]; // A22
+            a[i][j] = A[i][j]; // A11
+        }
+        for (int j = 0; j < n2; j++)
+        {
+            b[i][j] = A[i][j + n1]; // A12
         }
     }
+    for (int i = 0; i < n2; i++)
+    {
+        for (int j = 0; j < n1; j++)
+        {
+            c[i][j] = A[i + n1][j]; // A21
+        }
+        for (int j = 0; j < n2; j++)
+        {
+            d[i][j] = A[i + n1][j + n1]; // A22
+        }
+    }
+
+    double log_abs_det_a, log_abs_det_z;
+    int det_sign_a, det_sign_z;
+    double norm_A = norm_inf(A, size, size);
 
     // e = a^-1
-    strassen_inversion(a, e, newSize); // recursive call
+    int status = strassen_inversion(a, e, n1, &log_abs_det_a, &det_sign_a); // recursive call
+    if (status == OK && norm_inf(e, n1, n1) * norm_A > GROWTH_LIMIT)
+    {
+        status = CALCULATION_ERROR;
+    }
 
-    // z = d - c * e * b
-    strassen_mult(e, b, temp1, newSize);
-    strassen_mult(c, temp1, temp2, newSize);
-    subtract_matrix(d, temp2, z, newSize);
+    if (status == OK)
+    {
+        // c * e is only needed once t is known, it runs next to the whole Schur complement path
+#pragma omp task if (size > TASK_CUTOFF)
+        strassen_mult(c, e, ce, n2, n1, n1);
 
-    // t = z^-1
-    strassen_inversion(z, t, newSize); // recursive call
+        // z = d - c * e * b
+        strassen_mult(e, b, eb, n1, n1, n2);
+        strassen_mult(c, eb, temp1, n2, n1, n2);
+        subtract_matrix(d, temp1, z, n2, n2);
 
-    // y = -e * b * t
-    strassen_mult(b, t, temp1, newSize);
-    strassen_mult(e, temp1, y, newSize);
-    for (int i = 0; i < newSize; i++)
-    { // y = -(e * b * t)
-        for (int j = 0; j < newSize; j++)
+        // t = z^-1
+        status = strassen_inversion(z, t, n2, &log_abs_det_z, &det_sign_z); // recursive call
+        if (status == OK && norm_inf(t, n2, n2) * norm_A > GROWTH_LIMIT)
         {
-            y[i][j] = -y[i][j];
+            status = CALCULATION_ERROR;
         }
+
+#pragma omp taskwait
     }
 
-    // z = -t * c * e
-    strassen_mult(c, e, temp1, newSize);
-    strassen_mult(t, temp1, z, newSize);
-    for (int i = 0; i < newSize; i++)
-    { // z = -(t * c * e)
-        for (int j = 0; j < newSize; j++)
+    // Bad pivot block at this level: invert this subproblem with the pivoted LU leaf instead
+    if (status != OK)
+    {
+        status = lu_inversion(A, A_inv, size, log_abs_det, det_sign);
+    }
+    else
+    {
+        // det(A) = det(a) * det(z)
+        if (log_abs_det != NULL)
         {
-            z[i][j] = -z[i][j];
+            *log_abs_det = log_abs_det_a + log_abs_det_z;
+            *det_sign = det_sign_a * det_sign_z;
         }
-    }
 
-    // x = e + e * b * t * c * e
-    strassen_mult(b, t, temp1, newSize);     // temp1 = b * t
-    strassen_mult(temp1, c, temp2, newSize); // temp2 = (b * t) * c
-    strassen_mult(e, temp2, temp1, newSize); // temp1 = e * ((b * t) * c)
-    strassen_mult(temp1, e, temp2, newSize); // temp2 = (e * ((b * t) * c)) * e
-    add_matrix(e, temp2, x, newSize);        // x = e + (e * (b * t * c))
+        // y and then x = e + e * b * t * c * e = e - y * (c * e) in one task, w next to it
+#pragma omp task if (size > TASK_CUTOFF)
+        {
+            // y = -e * b * t
+            strassen_mult(eb, t, y, n1, n2, n2);
+            for (int i = 0; i < n1; i++)
+            { // y = -(e * b * t)
+                for (int j = 0; j < n2; j++)
+                {
+                    y[i][j] = -y[i][j];
+                }
+            }
 
-    // Combine x, y, z, t, into A_inv
-    for (int i = 0; i < newSize; i++)
-    {
-        for (int j = 0; j < newSize; j++)
+            // x = e - y * (c * e)
+            strassen_mult(y, ce, temp2, n1, n2, n1);
+            subtract_matrix(e, temp2, x, n1, n1);
+        }
+
+        // w = -t * c * e
+        strassen_mult(t, ce, w, n2, n2, n1);
+        for (int i = 0; i < n2; i++)
+        { // w = -(t * c * e)
+            for (int j = 0; j < n1; j++)
+            {
+                w[i][j] = -w[i][j];
+            }
+        }
+
+#pragma omp taskwait
+
+        // Combine x, y, w, t, into A_inv
+        for (int i = 0; i < n1; i++)
         {
-            A_inv[i][j] = x[i][j];                     // A_inv11
-            A_inv[i][j + newSize] = y[i][j];           // A_inv12
-            A_inv[i + newSize][j] = z[i][j];           // A_inv21
-            A_inv[i + newSize][j + newSize] = t[i][j]; // A_inv22
+            for (int j = 0; j < n1; j++)
+            {
+                A_inv[i][j] = x[i][j]; // A_inv11
+            }
+            for (int j = 0; j < n2; j++)
+            {
+                A_inv[i][j + n1] = y[i][j]; // A_inv12
+            }
+        }
+        for (int i = 0; i < n2; i++)
+        {
+            for (int j = 0; j < n1; j++)
+            {
+                A_inv[i + n1][j] = w[i][j]; // A_inv21
+            }
+            for (int j = 0; j < n2; j++)
+            {
+                A_inv[i + n1][j + n1] = t[i][j]; // A_inv22
+            }
         }
     }
 
     // Free allocated memory
-    free_matrix(a, newSize);
-    free_matrix(b, newSize);
-    free_matrix(c, newSize);
-    free_matrix(d, newSize);
-    free_matrix(e, newSize);
-    free_matrix(z, newSize);
-    free_matrix(t, newSize);
-    free_matrix(x, newSize);
-    free_matrix(y, newSize);
-    free_matrix(temp1, newSize);
-    free_matrix(temp2, newSize);
+    free_matrix(a, n1);
+    free_matrix(b, n1);
+    free_matrix(c, n2);
+    free_matrix(d, n2);
+    free_matrix(e, n1);
+    free_matrix(z, n2);
+    free_matrix(t, n2);
+    free_matrix(x, n1);
+    free_matrix(y, n1);
+    free_matrix(w, n2);
+    free_matrix(eb, n1);
+    free_matrix(ce, n2);
+    free_matrix(temp1, n2);
+    free_matrix(temp2, n1);
+    return status;
 }
 
-// Function to pad the matrix
-double **pad_matrix(double **original, int old_rows, int old_cols, int new_size)
+// Parallel entry point: one team of threads, the recursion below spawns the block products as nested tasks
+int parallel_strassen_inversion(double **A, double **A_inv, int size, double *log_abs_det, int *det_sign)
 {
-    double **padded_matrix = allocate_matrix(new_size);
+    int status = OK;
 
-    for (int i = 0; i < new_size; i++)
+#pragma omp parallel
+#pragma omp single
+    status = strassen_inversion(A, A_inv, size, log_abs_det, det_sign);
+
+    return status;
+}
+
+// R = I - A * X, returns ||R|| in the infinity norm
+double inversion_residual(double **A, double **X, double **R, int size)
+{
+    strassen_mult(A, X, R, size, size, size);
+    for (int i = 0; i < size; i++)
     {
-        for (int j = 0; j < new_size; j++)
+        for (int j = 0; j < size; j++)
         {
-            if (i < old_rows && j < old_cols)
-                padded_matrix[i][j] = original[i][j]; // Copy original value
-            else if (i == j)
-                padded_matrix[i][j] = 1.0;
-            else
-                padded_matrix[i][j] = 0.0; // Pad with zeros
+            R[i][j] = ((i == j) ? 1.0 : 0.0) - R[i][j];
         }
     }
-    return padded_matrix;
+    return norm_inf(R, size, size);
+}
+
+// Newton-Schulz iteration X <- X * (2I - A * X) = X + X * (I - A * X), every step is two Strassen products
+// warm_start = 1: X already holds an approximate inverse (a previous inverse of a nearby matrix, or the result of
+// strassen_inversion to be refined); it is used when ||I - A * X|| < 1, otherwise the scaled guess is taken
+// warm_start = 0: X0 = A^T / (||A||_1 * ||A||_inf), which always converges for a nonsingular A
+// X keeps the best iterate; CALCULATION_ERROR means the residual never reached the quadratic phase
+// (||I - A * X|| < 1/2), so A is singular or max_iterations was too small
+int newton_schulz_inversion(double **A, double **X, int size, int warm_start, double tolerance, int max_iterations,
+                            int *iterations, double *residual)
+{
+    double norm_one = 0.0;
+    for (int j = 0; j < size; j++)
+    {
+        double sum = 0.0;
+        for (int i = 0; i < size; i++)
+        {
+            sum += fabs(A[i][j]);
+        }
+        if (sum > norm_one)
+        {
+            norm_one = sum;
+        }
+    }
+    double scale_norm = norm_one * norm_inf(A, size, size);
+    if (scale_norm == 0.0 || !isfinite(scale_norm))
+    {
+        return CALCULATION_ERROR;
+    }
+
+    double **current = allocate_matrix(size, size);
+    double **next = allocate_matrix(size, size);
+    double **R = allocate_matrix(size, size);
+    double **XR = allocate_matrix(size, size);
+    double norm_R = 0.0;
+    int steps = 0;
+
+#pragma omp parallel
+#pragma omp single
+    {
+        if (warm_start)
+        {
+            for (int i = 0; i < size; i++)
+            {
+                for (int j = 0; j < size; j++)
+                {
+                    current[i][j] = X[i][j];
+                }
+            }
+            norm_R = inversion_residual(A, current, R, size);
+        }
+
+        // Scaled transpose as the initial guess
+        if (!warm_start || !(norm_R < 1.0))
+        {
+            double scale = 1.0 / scale_norm;
+            for (int i = 0; i < size; i++)
+            {
+                for (int j = 0; j < size; j++)
+                {
+                    current[i][j] = A[j][i] * scale;
+                }
+            }
+            norm_R = inversion_residual(A, current, R, size);
+        }
+
+        while (steps < max_iterations && norm_R > tolerance)
+        {
+            // next = X + X * (I - A * X)
+            strassen_mult(current, R, XR, size, size, size);
+            add_matrix(current, XR, next, size, size);
+            steps++;
+
+            double **swap = current;
+            current = next;
+            next = swap;
+            double norm_next = inversion_residual(A, current, R, size);
+
+            // In the quadratic phase a residual that no longer shrinks is the rounding floor, keep the previous iterate
+            if (norm_next >= norm_R && norm_R < 0.5)
+            {
+                swap = current;
+                current = next;
+                next = swap;
+                break;
+            }
+            norm_R = norm_next;
+        }
+    }
+
+    for (int i = 0; i < size; i++)
+    {
+        for (int j = 0; j < size; j++)
+        {
+            X[i][j] = current[i][j];
+        }
+    }
+    if (iterations != NULL)
+    {
+        *iterations = steps;
+    }
+    if (residual != NULL)
+    {
+        *residual = norm_R;
+    }
+
+    free_matrix(current, size);
+    free_matrix(next, size);
+    free_matrix(R, size);
+    free_matrix(XR, size);
+    return (norm_R < 0.5) ? OK : CALCULATION_ERROR;
 }
 
 // Function that request user to input Matrix elements
@@ -370,31 +1026,27 @@ void RequestInput(const char *name, double **matrix, int n)
     }
 }
 
-int next_power_of_two(int n)
-{
-    int power = 1;
-    while (power < n)
-    {
-        power *= 2;
-    }
-    return power;
-}
-
 int main()
 {
-    clock_t start_time, end_time;
+    struct timespec start_time, end_time;
     double cpu_time;
+    double log_abs_det;
+    int det_sign;
     // Step 1: Get dimensions for Matrix A
     int size;
     printf("\nChoose Matrix Dimension for the square matrix: ");
     scanf("%d", &size);
 
-    // Calculate padding_size
-    int padded_size = next_power_of_two(size);
+    // Error condition 1
+    if (size <= 0)
+    {
+        printf("Matrix Size can only be larger than zero, the program will exit...");
+        exit(1);
+    }
 
-    // Step 2: Allocate matrices memory
-    double **A = allocate_matrix(size);
-    double **A_inv = allocate_matrix(size);
+    // Step 2: Allocate matrices memory, any size works since the blocks are split unevenly
+    double **A = allocate_matrix(size, size);
+    double **A_inv = allocate_matrix(size, size);
 
     // Note: You can either enter the matrix input manually, or choose to fill the matrices automatically. But make sure to comment "RequestInput" function calls, and to uncomment the alternative random input option.
     // Step 3: Asking the user to input Matrix A and Matrix B elements
@@ -409,39 +1061,51 @@ int main()
         }
     }*/
 
-    // Step 3: Check that the matrix size is not power of 2
-    if (padded_size != size)
-    {
-        // Step 4: Apply padding for the matrices
-        double **A_padded = pad_matrix(A, size, size, padded_size);
-        double **A_inv_padded = pad_matrix(A_inv, size, size, padded_size);
+    // Step 4: Perform Strassen inversion based on strassen multiplication, timed on the wall clock since the work is spread over threads
+    timespec_get(&start_time, TIME_UTC);
+    int status = parallel_strassen_inversion(A, A_inv, size, &log_abs_det, &det_sign);
+    timespec_get(&end_time, TIME_UTC);
 
-        start_time = clock();
-        // Step 5: Perform Strassen inversion based on strassen multiplication
-        strassen_inversion(A_padded, A_inv_padded, padded_size);
-        end_time = clock();
+    // Error condition 2
+    if (status != OK)
+    {
+        printf("Matrix is singular, the program will exit...");
+        exit(1);
+    }
 
-        // Step 6: Print results
-        printMatrix("Matrix A:", A_padded, size);
-        printMatrix("Matrix A inverse:", A_inv_padded, size);
-        printf("\nTime taken for Strassen's Inversion using Strassen multiplication Algorithm: %.6f seconds\n", (double)(end_time - start_time) / CLOCKS_PER_SEC);
+    // Step 5: Newton-Schulz refinement of the Strassen inverse, recovers the accuracy lost to Strassen rounding
+    double **R = allocate_matrix(size, size);
+    double initial_residual = inversion_residual(A, A_inv, R, size);
+    free_matrix(R, size);
+    int iterations = 0;
+    double residual = initial_residual;
+    status = newton_schulz_inversion(A, A_inv, size, 1, NEWTON_SCHULZ_TOLERANCE, NEWTON_SCHULZ_MAX_ITERATIONS, &iterations,
+                                     &residual);
 
-    }
-    // No padding needed, since the matrix size is a power of 2
-    else
+    // Error condition 3
+    if (status != OK)
     {
-        start_time = clock();
-        // No padding needed, since the matrix size is a power of 2
-        // Step 5: Perform Strassen inversion based on strassen multiplication
-        strassen_inversion(A, A_inv, size);
-        end_time = clock();
-
-        // Step 6: Print results
-        printMatrix("Matrix A:", A, size);
-        printMatrix("Matrix A inverse:", A_inv, size);
-        printf("\nTime taken for Strassen's Algorithm: %.6f seconds\n", (double)(end_time - start_time) / CLOCKS_PER_SEC);
+        printf("Newton-Schulz refinement did not converge (||I - A * A_inv|| = %.3e after %d steps), the program will exit...",
+               residual, iterations);
+        exit(1);
+    }
 
+    // Step 6: Print results
+    printMatrix("Matrix A:", A, size);
+    printMatrix("Matrix A inverse:", A_inv, size);
+#ifdef _OPENMP
+    printf("\nThreads used: %d", omp_get_max_threads());
+#endif
+    printf("\nTime taken for Strassen's Inversion using Strassen multiplication Algorithm: %.6f seconds\n",
+           (double)(end_time.tv_sec - start_time.tv_sec) + (double)(end_time.tv_nsec - start_time.tv_nsec) / 1e9);
+    printf("Determinant: %.6e (sign %d, log|det| = %.6f)\n", det_sign * exp(log_abs_det), det_sign, log_abs_det);
+    if (!(initial_residual < 1.0))
+    {
+        // newton_schulz_inversion only warm starts from an inverse with ||I - A * X|| < 1
+        printf("Strassen inverse rejected as warm start, Newton-Schulz restarted from the scaled transpose\n");
     }
+    printf("||I - A * A_inv||: %.3e before, %.3e after %d Newton-Schulz steps\n", initial_residual, residual, iterations);
+
     // Step 7: Free memory
     free_matrix(A, size);
     free_matrix(A_inv, size);
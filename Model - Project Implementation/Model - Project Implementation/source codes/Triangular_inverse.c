@@ -0,0 +1,576 @@
+/*
+Group 03
+
+Hani Abdallah - 21400302
+Houssam Eddine Jamil Nasser - 21400407
+Tan Viet Nguyen - 21400381
+
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// Below this size the kernels switch to plain loops, same cut-off as strassen_mult
+#define BASE_CASE_SIZE 64
+
+enum ERROR_CODES
+{
+    OK,
+    INCORRECT_MATRIX,
+    CALCULATION_ERROR
+};
+
+// allocate memory for a rows x columns matrix
+double **allocate_matrix(int rows, int columns)
+{
+    double **matrix = (double **)malloc(rows * sizeof(double *));
+    for (int i = 0; i < rows; i++)
+    {
+        matrix[i] = (double *)malloc(columns * sizeof(double));
+    }
+    return matrix;
+}
+
+// free allocated memory of matrices
+void free_matrix(double **matrix, int rows)
+{
+    for (int i = 0; i < rows; i++)
+    {
+        free(matrix[i]);
+    }
+    free(matrix);
+}
+
+// Block of M starting at (row, column) seen as a matrix of its own, only the row pointers are allocated
+double **block_view(double **M, int row, int column, int rows)
+{
+    double **view = (double **)malloc(rows * sizeof(double *));
+    for (int i = 0; i < rows; i++)
+    {
+        view[i] = M[row + i] + column;
+    }
+    return view;
+}
+
+// Function to print a matrix
+void printMatrix(const char *name, double **matrix, int n)
+{
+    printf("%s:\n", name);
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            printf("%10.4f ", matrix[i][j]);
+        }
+        printf("\n");
+    }
+}
+
+// R = M * N with plain loops, M is m x k and N is k x n
+void nbasecase(double **M, double **N, double **R, int m, int k, int n)
+{
+    for (int i = 0; i < m; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            R[i][j] = 0.0;
+        }
+        for (int p = 0; p < k; p++)
+        {
+            double factor = M[i][p];
+            for (int j = 0; j < n; j++)
+            {
+                R[i][j] += factor * N[p][j];
+            }
+        }
+    }
+}
+
+// C = A + sign * B for rows x columns blocks
+void add_blocks(double **A, double **B, double **C, int rows, int columns, double sign)
+{
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < columns; j++)
+        {
+            C[i][j] = A[i][j] + sign * B[i][j];
+        }
+    }
+}
+
+// Strassen's algorithm for rectangular matrices: R = M * N, M is m x k and N is k x n
+// The seven products of strassen_mult run on the even part of every dimension,
+// an odd last row, column or inner index is peeled off and fixed up with plain loops
+void strassen_mult_rect(double **M, double **N, double **R, int m, int k, int n)
+{
+    if (m <= BASE_CASE_SIZE || k <= BASE_CASE_SIZE || n <= BASE_CASE_SIZE)
+    {
+        nbasecase(M, N, R, m, k, n);
+        return;
+    }
+
+    int m2 = m / 2, k2 = k / 2, n2 = n / 2;
+
+    // M and N submatrices (Blocks), as views
+    double **a = block_view(M, 0, 0, m2);
+    double **b = block_view(M, 0, k2, m2);
+    double **c = block_view(M, m2, 0, m2);
+    double **d = block_view(M, m2, k2, m2);
+    double **x = block_view(N, 0, 0, k2);
+    double **y = block_view(N, 0, n2, k2);
+    double **z = block_view(N, k2, 0, k2);
+    double **t = block_view(N, k2, n2, k2);
+
+    double **q1 = allocate_matrix(m2, n2);
+    double **q2 = allocate_matrix(m2, n2);
+    double **q3 = allocate_matrix(m2, n2);
+    double **q4 = allocate_matrix(m2, n2);
+    double **q5 = allocate_matrix(m2, n2);
+    double **q6 = allocate_matrix(m2, n2);
+    double **q7 = allocate_matrix(m2, n2);
+    double **temp1 = allocate_matrix(m2, k2);
+    double **temp2 = allocate_matrix(k2, n2);
+
+    // q1 = a * (x + z)
+    add_blocks(x, z, temp2, k2, n2, 1.0);
+    strassen_mult_rect(a, temp2, q1, m2, k2, n2);
+
+    // q2 = d * (y + t)
+    add_blocks(y, t, temp2, k2, n2, 1.0);
+    strassen_mult_rect(d, temp2, q2, m2, k2, n2);
+
+    // q3 = (d - a) * (z - y)
+    add_blocks(d, a, temp1, m2, k2, -1.0);
+    add_blocks(z, y, temp2, k2, n2, -1.0);
+    strassen_mult_rect(temp1, temp2, q3, m2, k2, n2);
+
+    // q4 = (b - d) * (z + t)
+    add_blocks(b, d, temp1, m2, k2, -1.0);
+    add_blocks(z, t, temp2, k2, n2, 1.0);
+    strassen_mult_rect(temp1, temp2, q4, m2, k2, n2);
+
+    // q5 = (b - a) * z
+    add_blocks(b, a, temp1, m2, k2, -1.0);
+    strassen_mult_rect(temp1, z, q5, m2, k2, n2);
+
+    // q6 = (c - a) * (x + y)
+    add_blocks(c, a, temp1, m2, k2, -1.0);
+    add_blocks(x, y, temp2, k2, n2, 1.0);
+    strassen_mult_rect(temp1, temp2, q6, m2, k2, n2);
+
+    // q7 = (c - d) * y
+    add_blocks(c, d, temp1, m2, k2, -1.0);
+    strassen_mult_rect(temp1, y, q7, m2, k2, n2);
+
+    // result matrix R (even part)
+    for (int i = 0; i < m2; i++)
+    {
+        for (int j = 0; j < n2; j++)
+        {
+            R[i][j] = q1[i][j] + q5[i][j];
+            R[i][j + n2] = q2[i][j] + q3[i][j] + q4[i][j] - q5[i][j];
+            R[i + m2][j] = q1[i][j] + q3[i][j] + q6[i][j] - q7[i][j];
+            R[i + m2][j + n2] = q2[i][j] + q7[i][j];
+        }
+    }
+
+    // Peeling: odd inner dimension adds a rank-1 term to the even part
+    if (k % 2)
+    {
+        for (int i = 0; i < 2 * m2; i++)
+        {
+            double factor = M[i][k - 1];
+            for (int j = 0; j < 2 * n2; j++)
+            {
+                R[i][j] += factor * N[k - 1][j];
+            }
+        }
+    }
+    // Odd last column, then odd last row
+    if (n % 2)
+    {
+        for (int i = 0; i < m; i++)
+        {
+            double sum = 0.0;
+            for (int p = 0; p < k; p++)
+            {
+                sum += M[i][p] * N[p][n - 1];
+            }
+            R[i][n - 1] = sum;
+        }
+    }
+    if (m % 2)
+    {
+        for (int j = 0; j < 2 * n2; j++)
+        {
+            R[m - 1][j] = 0.0;
+        }
+        for (int p = 0; p < k; p++)
+        {
+            double factor = M[m - 1][p];
+            for (int j = 0; j < 2 * n2; j++)
+            {
+                R[m - 1][j] += factor * N[p][j];
+            }
+        }
+    }
+
+    //  free allocated memory
+    free(a);
+    free(b);
+    free(c);
+    free(d);
+    free(x);
+    free(y);
+    free(z);
+    free(t);
+    free_matrix(q1, m2);
+    free_matrix(q2, m2);
+    free_matrix(q3, m2);
+    free_matrix(q4, m2);
+    free_matrix(q5, m2);
+    free_matrix(q6, m2);
+    free_matrix(q7, m2);
+    free_matrix(temp1, m2);
+    free_matrix(temp2, k2);
+}
+
+// C += A * B through strassen_mult_rect, A is m x k and B is k x n
+void add_product(double **A, double **B, double **C, int m, int k, int n)
+{
+    double **product = allocate_matrix(m, n);
+    strassen_mult_rect(A, B, product, m, k, n);
+    add_blocks(C, product, C, m, n, 1.0);
+    free_matrix(product, m);
+}
+
+// TRMM, B = L * B in place, L is m x m lower triangular and B is m x n
+// [B1; B2] = [L11 0; L21 L22] * [B1; B2]: B2 = L22 * B2 + L21 * B1 first (it still needs the old B1), then B1 = L11 * B1
+void trmm_left_lower(double **L, double **B, int m, int n)
+{
+    if (m <= BASE_CASE_SIZE)
+    {
+        for (int i = m - 1; i >= 0; i--)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                double sum = 0.0;
+                for (int p = 0; p <= i; p++)
+                {
+                    sum += L[i][p] * B[p][j];
+                }
+                B[i][j] = sum;
+            }
+        }
+        return;
+    }
+
+    int m1 = m / 2, m2 = m - m1;
+    double **L21 = block_view(L, m1, 0, m2);
+    double **L22 = block_view(L, m1, m1, m2);
+    double **B2 = block_view(B, m1, 0, m2);
+
+    trmm_left_lower(L22, B2, m2, n);
+    add_product(L21, B, B2, m2, m1, n);
+    trmm_left_lower(L, B, m1, n);
+
+    free(L21);
+    free(L22);
+    free(B2);
+}
+
+// TRMM, B = U * B in place, U is m x m upper triangular and B is m x n
+// [B1; B2] = [U11 U12; 0 U22] * [B1; B2]: B1 = U11 * B1 + U12 * B2 first (it needs the old B2), then B2 = U22 * B2
+void trmm_left_upper(double **U, double **B, int m, int n)
+{
+    if (m <= BASE_CASE_SIZE)
+    {
+        for (int i = 0; i < m; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                double sum = 0.0;
+                for (int p = i; p < m; p++)
+                {
+                    sum += U[i][p] * B[p][j];
+                }
+                B[i][j] = sum;
+            }
+        }
+        return;
+    }
+
+    int m1 = m / 2, m2 = m - m1;
+    double **U12 = block_view(U, 0, m1, m1);
+    double **U22 = block_view(U, m1, m1, m2);
+    double **B2 = block_view(B, m1, 0, m2);
+
+    trmm_left_upper(U, B, m1, n);
+    add_product(U12, B2, B, m1, m2, n);
+    trmm_left_upper(U22, B2, m2, n);
+
+    free(U12);
+    free(U22);
+    free(B2);
+}
+
+// TRMM, B = B * L in place, B is m x n and L is n x n lower triangular
+// [B1 B2] * [L11 0; L21 L22]: B1 = B1 * L11 + B2 * L21 first (it needs the old B2), then B2 = B2 * L22
+void trmm_right_lower(double **B, double **L, int m, int n)
+{
+    if (n <= BASE_CASE_SIZE)
+    {
+        for (int i = 0; i < m; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                double sum = 0.0;
+                for (int p = j; p < n; p++)
+                {
+                    sum += B[i][p] * L[p][j];
+                }
+                B[i][j] = sum;
+            }
+        }
+        return;
+    }
+
+    int n1 = n / 2, n2 = n - n1;
+    double **L21 = block_view(L, n1, 0, n2);
+    double **L22 = block_view(L, n1, n1, n2);
+    double **B2 = block_view(B, 0, n1, m);
+
+    trmm_right_lower(B, L, m, n1);
+    add_product(B2, L21, B, m, n2, n1);
+    trmm_right_lower(B2, L22, m, n2);
+
+    free(L21);
+    free(L22);
+    free(B2);
+}
+
+// TRMM, B = B * U in place, B is m x n and U is n x n upper triangular
+// [B1 B2] * [U11 U12; 0 U22]: B2 = B2 * U22 + B1 * U12 first (it needs the old B1), then B1 = B1 * U11
+void trmm_right_upper(double **B, double **U, int m, int n)
+{
+    if (n <= BASE_CASE_SIZE)
+    {
+        for (int i = 0; i < m; i++)
+        {
+            for (int j = n - 1; j >= 0; j--)
+            {
+                double sum = 0.0;
+                for (int p = 0; p <= j; p++)
+                {
+                    sum += B[i][p] * U[p][j];
+                }
+                B[i][j] = sum;
+            }
+        }
+        return;
+    }
+
+    int n1 = n / 2, n2 = n - n1;
+    double **U12 = block_view(U, 0, n1, n1);
+    double **U22 = block_view(U, n1, n1, n2);
+    double **B2 = block_view(B, 0, n1, m);
+
+    trmm_right_upper(B2, U22, m, n2);
+    add_product(B, U12, B2, m, n1, n2);
+    trmm_right_upper(B, U, m, n1);
+
+    free(U12);
+    free(U22);
+    free(B2);
+}
+
+// Recursive TRTRI for a lower triangular L, in place
+// [L11 0; L21 L22]^-1 = [X11 0; -X22 * L21 * X11 X22] with X11 = L11^-1 and X22 = L22^-1
+void trtri_lower(double **L, int n)
+{
+    if (n <= BASE_CASE_SIZE)
+    {
+        for (int j = n - 1; j >= 0; j--)
+        {
+            L[j][j] = 1.0 / L[j][j];
+            for (int i = n - 1; i > j; i--)
+            {
+                double sum = 0.0;
+                for (int p = j + 1; p <= i; p++)
+                {
+                    sum += L[i][p] * L[p][j];
+                }
+                L[i][j] = -sum * L[j][j];
+            }
+        }
+        return;
+    }
+
+    int n1 = n / 2, n2 = n - n1;
+    double **L21 = block_view(L, n1, 0, n2);
+    double **L22 = block_view(L, n1, n1, n2);
+
+    trtri_lower(L, n1);
+    trtri_lower(L22, n2);
+    trmm_right_lower(L21, L, n2, n1);
+    trmm_left_lower(L22, L21, n2, n1);
+    for (int i = 0; i < n2; i++)
+    {
+        for (int j = 0; j < n1; j++)
+        {
+            L21[i][j] = -L21[i][j];
+        }
+    }
+
+    free(L21);
+    free(L22);
+}
+
+// Recursive TRTRI for an upper triangular U, in place
+// [U11 U12; 0 U22]^-1 = [X11 -X11 * U12 * X22; 0 X22] with X11 = U11^-1 and X22 = U22^-1
+void trtri_upper(double **U, int n)
+{
+    if (n <= BASE_CASE_SIZE)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            U[j][j] = 1.0 / U[j][j];
+            for (int i = 0; i < j; i++)
+            {
+                double sum = 0.0;
+                for (int p = i; p < j; p++)
+                {
+                    sum += U[i][p] * U[p][j];
+                }
+                U[i][j] = -sum * U[j][j];
+            }
+        }
+        return;
+    }
+
+    int n1 = n / 2, n2 = n - n1;
+    double **U12 = block_view(U, 0, n1, n1);
+    double **U22 = block_view(U, n1, n1, n2);
+
+    trtri_upper(U, n1);
+    trtri_upper(U22, n2);
+    trmm_left_upper(U, U12, n1, n2);
+    trmm_right_upper(U12, U22, n1, n2);
+    for (int i = 0; i < n1; i++)
+    {
+        for (int j = 0; j < n2; j++)
+        {
+            U12[i][j] = -U12[i][j];
+        }
+    }
+
+    free(U12);
+    free(U22);
+}
+
+// Inverse of a triangular matrix (lower when lower is set, upper otherwise), only that triangle is read
+int triangular_inversion(double **T, double **T_inv, int n, int lower)
+{
+    if (T == NULL || T_inv == NULL || n < 1)
+    {
+        return INCORRECT_MATRIX;
+    }
+    for (int i = 0; i < n; i++)
+    {
+        if (T[i][i] == 0.0)
+        {
+            return CALCULATION_ERROR;
+        }
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            T_inv[i][j] = ((lower && j <= i) || (!lower && j >= i)) ? T[i][j] : 0.0;
+        }
+    }
+    if (lower)
+    {
+        trtri_lower(T_inv, n);
+    }
+    else
+    {
+        trtri_upper(T_inv, n);
+    }
+    return OK;
+}
+
+// Function that request user to input Matrix elements
+void RequestInput(const char *name, double **matrix, int n)
+{
+    printf("Input Matrix %s Elements:\n", name);
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            printf("%s[%d][%d]=", name, i, j);
+            scanf("%lf", &matrix[i][j]);
+        }
+    }
+}
+
+int main()
+{
+    clock_t start_time, end_time;
+    int size, lower;
+
+    // Step 1: Get dimensions for Matrix T and its shape
+    printf("\nChoose Matrix Dimension for the square matrix: ");
+    scanf("%d", &size);
+    printf("\nChoose the triangle (1: lower triangular, 0: upper triangular): ");
+    scanf("%d", &lower);
+
+    // Error condition 1
+    if (size <= 0)
+    {
+        printf("Matrix Size can only be larger than zero, the program will exit...");
+        exit(1);
+    }
+
+    // Step 2: Allocate matrices memory
+    double **T = allocate_matrix(size, size);
+    double **T_inv = allocate_matrix(size, size);
+
+    // Note: You can either enter the matrix input manually, or choose to fill the matrices automatically. But make sure to comment "RequestInput" function calls, and to uncomment the alternative random input option.
+    // Step 3: Asking the user to input Matrix T elements (the other triangle is ignored)
+    RequestInput("T", T, size);
+
+    // This is an alternative random input option, but make sure to comment "RequestInput" function calls.
+    /*for (int i = 0; i < size; i++)
+    {
+        for (int j = 0; j < size; j++)
+        {
+            T[i][j] = (i == j) ? 1.0 : ((double)rand() / RAND_MAX) / size;
+        }
+    }*/
+
+    // Step 4: Perform the recursive triangular inversion
+    start_time = clock();
+    int status = triangular_inversion(T, T_inv, size, lower != 0);
+    end_time = clock();
+
+    // Error condition 2
+    if (status != OK)
+    {
+        printf("Matrix has a zero on its diagonal and is singular, the program will exit...");
+        exit(1);
+    }
+
+    // Step 5: Print results
+    printMatrix("Matrix T inverse", T_inv, size);
+    printf("\nTime taken for the recursive triangular inversion: %.6f seconds\n", (double)(end_time - start_time) / CLOCKS_PER_SEC);
+
+    // Step 6: Free memory
+    free_matrix(T, size);
+    free_matrix(T_inv, size);
+
+    return 0;
+}